@@ -0,0 +1,921 @@
+#include "fractal_renderer.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Vertex shader kodu
+const char *fractalVertexShaderSource = R"(
+    #version 330 core
+    layout (location = 0) in vec3 aPos;
+    layout (location = 1) in vec2 aTexCoord;
+    out vec2 TexCoord;
+    void main() {
+        gl_Position = vec4(aPos, 1.0);
+        TexCoord = aTexCoord;
+    }
+)";
+
+// Tüm fragment shader'ların ortak başlığı: paletler, iterasyon ve renklendirme
+// (#version satırı ve telemetri tanımları çalışma zamanında eklenir)
+static const char *fragmentCommonSource = R"(
+    uniform vec2 resolution;
+    uniform float time;
+    uniform int mode;
+    
+    #define MAX_ITER 200 // Daha hızlı iterasyonlar için düşürüldü, daha akışkan hareket
+    #define PI 3.14159265359
+    #define TAU 6.28318530718
+    #define INTERIOR_ITER -1.0e6 // Kaçmayan (iç bölge) pikseller için işaret değeri
+    
+    // Psychedelic renk paletleri
+    vec3 psychedelicPalette1(float t) {
+        // Hızlı, canlı, dönen tonlar
+        vec3 color = 0.5 + 0.5 * cos(TAU * (t * 3.0 + vec3(0.0, 0.333, 0.666) + time * 0.5));
+        return clamp(color, 0.0, 1.0); // Renk değerlerini 0-1 aralığında tutmak için
+    }
+
+    vec3 psychedelicPalette2(float t) {
+        // Kontrastlı, şok edici renk geçişleri
+        vec3 c1 = vec3(1.0, 0.0, 0.5); // Magenta
+        vec3 c2 = vec3(0.0, 1.0, 0.8); // Turkuaz
+        vec3 c3 = vec3(1.0, 0.8, 0.0); // Turuncu
+        vec4 c4 = vec4(0.5, 0.0, 1.0, 1.0); // Mor (alpha ile uyum için)
+
+        t = fract(t + time * 0.2); // Daha hızlı kayma
+        if (t < 0.25) return mix(c1, c2, smoothstep(0.0, 1.0, t * 4.0));
+        else if (t < 0.5) return mix(c2, c3, smoothstep(0.0, 1.0, (t - 0.25) * 4.0));
+        else if (t < 0.75) return mix(c3, c4.rgb, smoothstep(0.0, 1.0, (t - 0.5) * 4.0));
+        else return mix(c4.rgb, c1, smoothstep(0.0, 1.0, (t - 0.75) * 4.0));
+    }
+
+    vec3 quantumFlux(float t) {
+        // Kuantum fiziği esinlenmesi, daha dinamik ve parlayan
+        float wave = sin(t * 30.0 + time * 5.0) * 0.5 + 0.5; // Daha hızlı titreşim
+        vec3 photon = vec3(1.0, 1.0, 0.8) * (1.0 + sin(time * 7.0) * 0.1); // Parlama
+        vec3 electron = vec3(0.2, 0.4, 1.0) * (1.0 + cos(time * 6.0) * 0.1);
+        vec3 quantum = vec3(0.8, 0.2, 0.8) * (1.0 + sin(time * 8.0) * 0.1);
+        
+        return mix(mix(photon, electron, wave), quantum, sin(t * 10.0 + time * 3.0) * 0.5 + 0.5);
+    }
+
+    vec3 cosmicPalette(float t) {
+        // Derin uzay ve nebula renkleri, daha akışkan
+        vec3 deep = vec3(0.05, 0.0, 0.2); 
+        vec3 nebula = vec3(0.8, 0.2, 0.9); 
+        vec3 star = vec3(1.0, 0.9, 0.3); 
+        vec3 plasma = vec3(0.0, 0.8, 1.0); 
+        
+        t = fract(t + time * 0.05) * 4.0; // Hafif kayma
+        if(t < 1.0) return mix(deep, nebula, smoothstep(0.0, 1.0, t));
+        else if(t < 2.0) return mix(nebula, star, smoothstep(0.0, 1.0, t-1.0));
+        else if(t < 3.0) return mix(star, plasma, smoothstep(0.0, 1.0, t-2.0));
+        return mix(plasma, deep, smoothstep(0.0, 1.0, t-3.0));
+    }
+    
+    // Ana color function
+    vec3 getColor(float t, int colorMode, float time) {
+        switch(colorMode) {
+            case 0: return psychedelicPalette1(t);
+            case 1: return psychedelicPalette2(t);
+            case 2: return quantumFlux(t);
+            case 3: return cosmicPalette(t);
+            default: return psychedelicPalette1(t);
+        }
+    }
+    
+    // Julia iterasyonu: yumuşatılmış kaçış süresi ya da INTERIOR_ITER
+    int juliaIterations; // Son çağrının iterasyon sayısı (telemetri için)
+    float juliaEscape(vec2 z, vec2 c) {
+        for(int iter = 0; iter < MAX_ITER; iter++) {
+            float x = z.x * z.x - z.y * z.y + c.x;
+            float y = 2.0 * z.x * z.y + c.y;
+            
+            float magnitudeSq = x*x + y*y;
+            if(magnitudeSq > 4.0) {
+                juliaIterations = iter + 1;
+                return float(iter) + 1.0 - log2(log2(magnitudeSq));
+            }
+            z = vec2(x, y);
+        }
+        juliaIterations = MAX_ITER;
+        return INTERIOR_ITER;
+    }
+    
+    // Telemetri sayaçları: atomik çekişmesini düşük tutmak için her
+    // TELEMETRY_STRIDE x TELEMETRY_STRIDE bloktan yalnızca bir piksel sayılır
+    #ifdef TELEMETRY
+    layout(std430, binding = 0) buffer TelemetryCounters {
+        uint iterationCount;
+        uint escapedCount;
+        uint interiorCount;
+    };
+    #endif
+    
+    void recordTelemetry(float smoothIter) {
+    #ifdef TELEMETRY
+        ivec2 pixel = ivec2(gl_FragCoord.xy);
+        if(((pixel.x | pixel.y) & (TELEMETRY_STRIDE - 1)) == 0) {
+            atomicAdd(iterationCount, uint(juliaIterations));
+            if(smoothIter <= INTERIOR_ITER) atomicAdd(interiorCount, 1u);
+            else atomicAdd(escapedCount, 1u);
+        }
+    #endif
+    }
+    
+    // Kaçış süresinden nihai renk
+    vec3 shadeJulia(float smoothIter, vec2 originalUV) {
+        if(smoothIter <= INTERIOR_ITER) {
+            // İç bölge için hareketli bir desen
+            float innerPattern = sin(length(originalUV) * 30.0 + time * 10.0) * 0.5 + 0.5;
+            return getColor(innerPattern, mode, time) * 0.2;
+        }
+        
+        // Gelişmiş renk hesaplaması
+        float normalizedIter = smoothIter / float(MAX_ITER);
+        vec3 color = getColor(normalizedIter, mode, time);
+        
+        // Artistik efektler - daha fazla parıltı ve titreşim
+        float glow = exp(-smoothIter * 0.01) * (0.5 + sin(time * 5.0) * 0.5);
+        color += getColor(time * 0.2, (mode + 1) % 4, time) * glow * 2.0;
+        
+        // Vignette efekti - daha dramatik
+        float vignette = 1.0 - length(originalUV) * 0.8;
+        vignette = smoothstep(0.0, 1.0, vignette);
+        vignette = pow(vignette, 2.0);
+        
+        // Dynamic brightness - daha belirgin nabız atışı
+        float pulse = sin(time * 4.0) * 0.3 + 0.7;
+        color *= vignette * pulse;
+        
+        // HDR ve Tonemap - daha parlak ve dinamik
+        color = color / (0.1 + color);
+        color = pow(color, vec3(1.0 / 2.0));
+
+        // Film grain effect - hafif kumlanma
+        float grain = fract(sin(dot(originalUV * resolution, vec2(12.9898, 78.233))) * 43758.5453);
+        color += (grain - 0.5) * 0.03;
+        return color;
+    }
+)";
+
+// Fragment shader kodu - Sanatsal ve Psychedelic geliştirmeler
+static const char *fragmentShaderSource = R"(
+    out vec4 FragColor;
+    in vec2 TexCoord;
+    
+    uniform float zoom;
+    uniform vec2 offset;
+    uniform vec2 juliaParam;
+    uniform float complexity;
+    
+    // Video girişi: YUV 4:2:0 düzlemleri ayrı R8 dokularda
+    uniform sampler2D videoY;
+    uniform sampler2D videoU;
+    uniform sampler2D videoV;
+    uniform float videoAmount; // 0 = video kapalı
+    
+    vec3 videoColor(vec2 texCoord) {
+        // Video satırları yukarıdan aşağıya yüklenir
+        vec2 st = vec2(texCoord.x, 1.0 - texCoord.y);
+        float y = (texture(videoY, st).r - 0.0625) * 1.164;
+        float u = texture(videoU, st).r - 0.5;
+        float v = texture(videoV, st).r - 0.5;
+        // BT.601 sınırlı aralık
+        return clamp(vec3(y + 1.596 * v, y - 0.392 * u - 0.813 * v, y + 2.017 * u), 0.0, 1.0);
+    }
+    
+    // Gelişmiş geometrik transformasyonlar
+    vec2 kaleidoscope(vec2 uv, float segments) {
+        float angle = atan(uv.y, uv.x);
+        float radius = length(uv);
+        angle = mod(angle, TAU / segments);
+        angle = abs(angle - PI / segments);
+        return vec2(cos(angle), sin(angle)) * radius;
+    }
+    
+    vec2 fractalDistortion(vec2 uv, float time, float intensity) {
+        // Çoklu fraktal katmanları ve girdap etkisi
+        float scale1 = 3.0, scale2 = 7.0, scale3 = 13.0;
+        
+        vec2 distort = vec2(
+            sin(uv.y * scale1 + time * 1.5) * sin(uv.x * scale2 + time * 1.3) * intensity,
+            cos(uv.x * scale1 + time * 1.7) * cos(uv.y * scale3 + time * 1.9) * intensity
+        );
+        
+        // Girdap deformasyonu
+        float angle = atan(uv.y, uv.x);
+        float dist = length(uv);
+        float swirl = sin(dist * 10.0 - time * 2.0) * 0.05 * intensity;
+        angle += swirl;
+        distort += vec2(cos(angle), sin(angle)) * dist * 0.1 * intensity;
+
+        return uv + distort;
+    }
+    
+    void main() {
+        vec2 uv = (gl_FragCoord.xy - 0.5 * resolution.xy) / min(resolution.x, resolution.y);
+        vec2 originalUV = uv;
+        
+        // Dinamik zoom ve solunum efekti - daha belirgin
+        float breathe = sin(time * 0.7) * 0.2 + 1.0;
+        float dynamicZoom = zoom * (1.0 + sin(time * 0.1) * 0.5);
+        uv = uv * (3.0 / dynamicZoom) * breathe;
+        
+        // Karmaşıklık seviyesine göre transformasyonlar - daha etkileşimli
+        uv = kaleidoscope(uv, 4.0 + sin(time * 0.4) * 3.0 + complexity * 5.0);
+        
+        // Fraktal distorsiyon - karmaşıklıkla daha yoğun
+        uv = fractalDistortion(uv, time, complexity * 0.5 + sin(time * 0.8) * 0.1);
+        uv += offset;
+        
+        // Julia parametrelerinde harmonic motion - daha hızlı ve geniş
+        vec2 c = juliaParam;
+        c.x += sin(time * 0.25) * 0.2 * complexity;
+        c.y += cos(time * 0.35) * 0.2 * complexity;
+        
+        // Video ile yer değiştirme: renk kanalları düzlemi iter, parlaklık julia parametresini kaydırır
+        vec3 video = vec3(0.0);
+        if(videoAmount > 0.0) {
+            video = videoColor(TexCoord);
+            float luma = dot(video, vec3(0.299, 0.587, 0.114));
+            uv += (video.rg - 0.5) * 0.3 * videoAmount;
+            c += vec2(luma - 0.5) * 0.1 * videoAmount;
+        }
+        
+        // Ana fraktal hesaplama
+        float smoothIter = juliaEscape(uv, c);
+        recordTelemetry(smoothIter);
+        vec3 color = shadeJulia(smoothIter, originalUV);
+        if(videoAmount > 0.0) {
+            // Paleti videonun renkleriyle boya
+            color = mix(color, color * video * 2.0, 0.5 * videoAmount);
+        }
+        FragColor = vec4(color, 1.0);
+    }
+)";
+
+// 3D quaternion julia: ışın üretimi, uzaklık tahmini (DE) ve kamera.
+// julia_fractal.cpp'deki CPU yolu (renderQuaternionCPU) aynı formülleri
+// kullanır; biri değişirse diğeri de güncellenmeli.
+static const char *quaternionCommonSource = R"(
+    uniform float zoom;
+    uniform vec2 offset;
+    uniform vec2 juliaParam;
+    uniform float complexity;
+    
+    #define QJ_ITER 11
+    #define QJ_BOUND 2.0       // Kümeyi içeren kürenin yarıçapı
+    #define FOCAL 1.8
+    #define CONE_DOWNSAMPLE 8  // Ön geçişte bir pikselin kapladığı blok kenarı
+    #define MARCH_STEPS 96
+    
+    vec4 quaternionC() {
+        return vec4(juliaParam, 0.2 + 0.1 * sin(time * 0.3) * complexity, 0.0);
+    }
+    
+    // z -> z^2 + c; dönüş değeri DE, trap yörüngenin orijine en yakın karesi
+    float quaternionDE(vec3 p, vec4 c, out float trap) {
+        vec4 z = vec4(p, 0.0);
+        float md2 = 1.0;
+        float mz2 = dot(z, z);
+        trap = 1e10;
+        for(int i = 0; i < QJ_ITER; i++) {
+            md2 *= 4.0 * mz2;
+            z = vec4(z.x * z.x - dot(z.yzw, z.yzw), 2.0 * z.x * z.yzw) + c;
+            trap = min(trap, dot(z.xyz, z.xyz));
+            mz2 = dot(z, z);
+            if(mz2 > 16.0) break;
+        }
+        return 0.25 * sqrt(mz2 / md2) * log(mz2);
+    }
+    
+    // Sürükleme kamerayı yörüngede döndürür, zoom uzaklığı belirler
+    void cameraRay(vec2 fragCoord, out vec3 ro, out vec3 rd) {
+        float dist = 7.5 / zoom;
+        float yaw = time * 0.1 + offset.x * 2.0;
+        float pitch = clamp(offset.y * 2.0, -1.4, 1.4);
+        ro = dist * vec3(cos(pitch) * sin(yaw), sin(pitch), cos(pitch) * cos(yaw));
+        vec3 forward = normalize(-ro);
+        vec3 right = normalize(cross(forward, vec3(0.0, 1.0, 0.0)));
+        vec3 up = cross(right, forward);
+        vec2 uv = (fragCoord - 0.5 * resolution) / resolution.y;
+        rd = normalize(forward * FOCAL + right * uv.x + up * uv.y);
+    }
+    
+    // Işının sınır küresine giriş/çıkış uzaklıkları; ıskalarsa x > y
+    vec2 boundRange(vec3 ro, vec3 rd) {
+        float b = dot(ro, rd);
+        float h = b * b - dot(ro, ro) + QJ_BOUND * QJ_BOUND;
+        if(h < 0.0) return vec2(1.0, 0.0);
+        h = sqrt(h);
+        return vec2(max(-b - h, 0.0), -b + h);
+    }
+)";
+
+// Koni ön geçişi: her CONE_DOWNSAMPLE x CONE_DOWNSAMPLE blok için bloğu
+// kapsayan koniyi yüzeye kadar ilerletir ve güvenli başlangıç uzaklığını yazar
+static const char *coneShaderSource = R"(
+    out float StartDistance;
+    
+    void main() {
+        vec2 blockCenter = gl_FragCoord.xy * float(CONE_DOWNSAMPLE);
+        vec3 ro, rd;
+        cameraRay(blockCenter, ro, rd);
+        vec2 range = boundRange(ro, rd);
+        // Koninin yarıçap/uzaklık oranı: bloğun yarı köşegeni
+        float coneSlope = float(CONE_DOWNSAMPLE) * 0.7072 / (resolution.y * FOCAL);
+        
+        vec4 c = quaternionC();
+        float trap;
+        float t = range.x;
+        float safeT = t;
+        for(int i = 0; i < MARCH_STEPS && t < range.y; i++) {
+            float d = quaternionDE(ro + rd * t, c, trap);
+            if(d < t * coneSlope) break;
+            safeT = t;
+            t += d;
+        }
+        StartDistance = range.x > range.y ? 1e10 : (t >= range.y ? t : safeT);
+    }
+)";
+
+// 3D ana geçiş: ön geçişin başlangıç uzaklığından piksel başına raymarch
+static const char *quaternionShaderSource = R"(
+    out vec4 FragColor;
+    
+    uniform sampler2D coneDepth;
+    
+    vec3 quaternionNormal(vec3 p, vec4 c, float eps) {
+        // Dörtyüzlü örnekleme: 4 DE değerlendirmesi
+        const vec2 k = vec2(1.0, -1.0);
+        float trap;
+        return normalize(k.xyy * quaternionDE(p + k.xyy * eps, c, trap) +
+                         k.yyx * quaternionDE(p + k.yyx * eps, c, trap) +
+                         k.yxy * quaternionDE(p + k.yxy * eps, c, trap) +
+                         k.xxx * quaternionDE(p + k.xxx * eps, c, trap));
+    }
+    
+    void main() {
+        vec3 ro, rd;
+        cameraRay(gl_FragCoord.xy, ro, rd);
+        vec2 range = boundRange(ro, rd);
+        float pixelSlope = 1.0 / (resolution.y * FOCAL);
+        
+        vec4 c = quaternionC();
+        float trap = 0.0;
+        float t = max(texelFetch(coneDepth, ivec2(gl_FragCoord.xy) / CONE_DOWNSAMPLE, 0).r, range.x);
+        bool hit = false;
+        int steps = 0;
+        for(; steps < MARCH_STEPS && t < range.y; steps++) {
+            float d = quaternionDE(ro + rd * t, c, trap);
+            if(d < t * pixelSlope * 0.5) {
+                hit = true;
+                break;
+            }
+            t += d;
+        }
+        
+        // Raymarch adımları julia iterasyonu değildir; 3D kareler iterasyon ve
+        // iç/kaçan piksel sayaçlarına katılmaz
+        
+        vec3 color = getColor(0.5 + rd.y * 0.2, mode, time) * 0.15;
+        if(hit) {
+            vec3 p = ro + rd * t;
+            vec3 n = quaternionNormal(p, c, t * pixelSlope);
+            vec3 lightDir = normalize(vec3(0.6, 0.8, 0.4));
+            float diffuse = max(dot(n, lightDir), 0.0);
+            float specular = pow(max(dot(reflect(rd, n), lightDir), 0.0), 24.0);
+            // Normal boyunca DE örnekleriyle ortam kapatma (başlangıç uzaklığından bağımsız)
+            float occlusion = 0.0;
+            for(int i = 1; i <= 3; i++) {
+                float h = 0.04 * float(i);
+                occlusion += (h - quaternionDE(p + n * h, c, trap)) / float(i);
+            }
+            occlusion = clamp(1.0 - 4.0 * occlusion, 0.0, 1.0);
+            quaternionDE(p, c, trap);
+            vec3 base = getColor(sqrt(trap) * 0.5, mode, time);
+            color = (base * (0.2 + 0.8 * diffuse) + specular * 0.4) * occlusion;
+        }
+        color = pow(clamp(color, 0.0, 1.0), vec3(1.0 / 2.2));
+        FragColor = vec4(color, 1.0);
+    }
+)";
+
+// Tüm örneklerin paylaştığı programlar ve uniform lokasyonları
+struct FractalUniforms
+{
+    GLint time, resolution, mode, zoom, offset, juliaParam, complexity;
+};
+
+struct FractalPrograms
+{
+    GLuint classic, cone, quaternion;
+    FractalUniforms classicUniforms, coneUniforms, quaternionUniforms;
+    GLint videoAmountLocation;
+    const void *context; // Programların ait olduğu context
+    int references;
+};
+
+static FractalShaderOptions shaderOptions;
+// Context başına paylaşılan programlar
+static std::unordered_map<const void *, FractalPrograms *> programCache;
+static std::mutex programCacheMutex; // Yalnızca önbelleği ve referans sayımını korur
+
+void setFractalShaderOptions(const FractalShaderOptions &options)
+{
+    shaderOptions = options;
+}
+
+// Shader derleme ve bağlama
+// Birden fazla kaynak parçasından (ortak başlık + gövde) shader derle
+static GLuint createShader(const char *const *sources, GLsizei count, GLenum type)
+{
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, count, sources, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cerr << "Shader compilation error: " << infoLog << std::endl;
+    }
+    return shader;
+}
+
+// Vertex shader ile ortak başlık + gövdeden oluşan fragment shader'ı bağla;
+// bağlama başarısızsa 0 döner
+GLuint createFractalProgram(const char *name, const char *vertexSource, const char *fragmentBody)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::string prelude = "#version 330 core\n";
+    if (shaderOptions.telemetryCounters)
+        prelude = "#version 430 core\n#define TELEMETRY 1\n#define TELEMETRY_STRIDE " +
+                  std::to_string(shaderOptions.telemetryStride) + "\n";
+    const char *fragmentSources[] = {prelude.c_str(), fragmentCommonSource, fragmentBody};
+    GLuint vertexShader = createShader(&vertexSource, 1, GL_VERTEX_SHADER);
+    GLuint fragmentShader = createShader(fragmentSources, 3, GL_FRAGMENT_SHADER);
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "Shader program linking error (" << name << "): " << infoLog << std::endl;
+        glDeleteProgram(program);
+        program = 0;
+    }
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    // Bağlama durumu sorgusu derlemenin bitmesini beklediği için süre gerçekçi
+    if (shaderOptions.onProgramCompiled)
+        shaderOptions.onProgramCompiled(name, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                  std::chrono::steady_clock::now() - start)
+                                                  .count());
+    return program;
+}
+
+// Quad mesh oluşturma
+void createFractalQuad(GLuint &vao, GLuint &vbo)
+{
+    float quadVertices[] = {
+        // Pozisyonlar   // Texture koordinatları
+        -1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
+        -1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
+        1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+
+        -1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
+        1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+        1.0f, 1.0f, 0.0f, 1.0f, 1.0f};
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void *)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+}
+
+static FractalUniforms uniformLocations(GLuint program)
+{
+    FractalUniforms u;
+    u.time = glGetUniformLocation(program, "time");
+    u.resolution = glGetUniformLocation(program, "resolution");
+    u.mode = glGetUniformLocation(program, "mode");
+    u.zoom = glGetUniformLocation(program, "zoom");
+    u.offset = glGetUniformLocation(program, "offset");
+    u.juliaParam = glGetUniformLocation(program, "juliaParam");
+    u.complexity = glGetUniformLocation(program, "complexity");
+    return u;
+}
+
+static void setUniforms(const FractalUniforms &u, const FractalParams &p, int width, int height)
+{
+    glUniform1f(u.time, p.time);
+    glUniform2f(u.resolution, (float)width, (float)height);
+    glUniform1i(u.mode, p.colorMode);
+    glUniform1f(u.zoom, p.zoom);
+    glUniform2f(u.offset, p.offsetX, p.offsetY);
+    glUniform2f(u.juliaParam, p.juliaX, p.juliaY);
+    glUniform1f(u.complexity, p.complexity);
+}
+
+// Aktif GL context'inin tanıtıcısı. GLEW hangi pencere sistemiyle
+// kullanıldığını bilmediği için WGL dışında GLX ve EGL sırayla denenir.
+static const void *currentContext()
+{
+#ifdef _WIN32
+    return wglGetCurrentContext();
+#else
+    typedef void *(*GetCurrentContextProc)(void);
+    static GetCurrentContextProc glxCurrent = (GetCurrentContextProc)dlsym(RTLD_DEFAULT, "glXGetCurrentContext");
+    static GetCurrentContextProc eglCurrent = (GetCurrentContextProc)dlsym(RTLD_DEFAULT, "eglGetCurrentContext");
+    void *context = glxCurrent ? glxCurrent() : NULL;
+    if (!context && eglCurrent)
+        context = eglCurrent();
+    return context;
+#endif
+}
+
+// Programları context'in ilk örneğinde derle, sonrakilerde yalnızca referans say
+static FractalPrograms *acquirePrograms()
+{
+    const void *context = currentContext();
+    std::lock_guard<std::mutex> lock(programCacheMutex);
+    FractalPrograms *&cached = programCache[context];
+    if (!cached)
+    {
+        std::string coneBody = std::string(quaternionCommonSource) + coneShaderSource;
+        std::string quaternionBody = std::string(quaternionCommonSource) + quaternionShaderSource;
+        FractalPrograms programs = {};
+        programs.classic = createFractalProgram("classic", fractalVertexShaderSource, fragmentShaderSource);
+        programs.cone = createFractalProgram("quaternion_cone", fractalVertexShaderSource, coneBody.c_str());
+        programs.quaternion = createFractalProgram("quaternion", fractalVertexShaderSource, quaternionBody.c_str());
+        if (!programs.classic || !programs.cone || !programs.quaternion)
+        {
+            glDeleteProgram(programs.classic);
+            glDeleteProgram(programs.cone);
+            glDeleteProgram(programs.quaternion);
+            programCache.erase(context);
+            return nullptr;
+        }
+
+        programs.classicUniforms = uniformLocations(programs.classic);
+        programs.coneUniforms = uniformLocations(programs.cone);
+        programs.quaternionUniforms = uniformLocations(programs.quaternion);
+        programs.videoAmountLocation = glGetUniformLocation(programs.classic, "videoAmount");
+
+        // Video düzlemleri 1-3, koni derinliği 0 numaralı doku biriminde
+        glUseProgram(programs.classic);
+        glUniform1i(glGetUniformLocation(programs.classic, "videoY"), 1);
+        glUniform1i(glGetUniformLocation(programs.classic, "videoU"), 2);
+        glUniform1i(glGetUniformLocation(programs.classic, "videoV"), 3);
+        glUseProgram(programs.quaternion);
+        glUniform1i(glGetUniformLocation(programs.quaternion, "coneDepth"), 0);
+
+        programs.context = context;
+        cached = new FractalPrograms(programs);
+    }
+    cached->references++;
+    return cached;
+}
+
+// Programların context'i aktifken çağrılmalı
+static void releasePrograms(FractalPrograms *programs)
+{
+    std::lock_guard<std::mutex> lock(programCacheMutex);
+    if (--programs->references > 0)
+        return;
+    glDeleteProgram(programs->classic);
+    glDeleteProgram(programs->cone);
+    glDeleteProgram(programs->quaternion);
+    programCache.erase(programs->context);
+    delete programs;
+}
+
+FractalRenderer::FractalRenderer()
+{
+    fractal_default_params(&params);
+}
+
+bool FractalRenderer::init(int width, int height)
+{
+    programs = acquirePrograms();
+    if (!programs)
+        return false;
+    createFractalQuad(quadVAO, quadVBO);
+    glGenFramebuffers(1, &coneFramebuffer);
+    glGenTextures(1, &coneTexture);
+    if (width > 0 && height > 0)
+        return resize(width, height);
+    return true;
+}
+
+void FractalRenderer::destroy()
+{
+    if (!programs)
+        return;
+    glDeleteTextures(1, &targetTexture);
+    glDeleteFramebuffers(1, &targetFramebuffer);
+    glDeleteTextures(1, &coneTexture);
+    glDeleteFramebuffers(1, &coneFramebuffer);
+    glDeleteVertexArrays(1, &quadVAO);
+    glDeleteBuffers(1, &quadVBO);
+    targetFramebuffer = targetTexture = coneFramebuffer = coneTexture = quadVAO = quadVBO = 0;
+    targetWidth = targetHeight = coneWidth = coneHeight = 0;
+    releasePrograms(programs);
+    programs = nullptr;
+}
+
+void FractalRenderer::setVideoTextures(GLuint y, GLuint u, GLuint v)
+{
+    videoTextures[0] = y;
+    videoTextures[1] = u;
+    videoTextures[2] = v;
+}
+
+// Ekran dışı RGBA8 hedefini (yeniden) oluştur
+bool FractalRenderer::resize(int width, int height)
+{
+    if (!programs || width <= 0 || height <= 0)
+        return false;
+    if (width == targetWidth && height == targetHeight)
+        return true;
+    if (!targetTexture)
+    {
+        glGenTextures(1, &targetTexture);
+        glGenFramebuffers(1, &targetFramebuffer);
+    }
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, targetTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, targetTexture, 0);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    targetWidth = complete ? width : 0;
+    targetHeight = complete ? height : 0;
+    return complete;
+}
+
+void FractalRenderer::render()
+{
+    FractalRenderer *self = this;
+    renderBatch(&self, 1);
+}
+
+void FractalRenderer::renderTo(GLuint framebuffer, int width, int height)
+{
+    if (!programs)
+        return;
+    View view = {this, framebuffer, width, height};
+    drawViews(&view, 1);
+}
+
+void FractalRenderer::renderBatch(FractalRenderer *const *renderers, int count)
+{
+    std::vector<View> views;
+    views.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        FractalRenderer *renderer = renderers[i];
+        if (renderer && renderer->programs && renderer->targetFramebuffer && renderer->targetWidth > 0)
+            views.push_back({renderer, renderer->targetFramebuffer, renderer->targetWidth, renderer->targetHeight});
+    }
+    if (views.empty())
+        return;
+    drawViews(views.data(), (int)views.size());
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    // Tüm görünümler tek seferde sürücüye gönderilir
+    glFlush();
+}
+
+// Görünümleri programa göre grupla: her program bir kez bağlanır. 3D görünümlerde
+// önce tüm koni geçişleri, sonra bu dokuları okuyan ana geçişler çizilir.
+void FractalRenderer::drawViews(const View *views, int count)
+{
+    // Görünümler aynı context'te olduğundan programları da aynıdır; yine de
+    // her görünüm kendi referansını kullanır, program yalnızca değişince bağlanır
+    GLuint bound = 0;
+    for (int i = 0; i < count; i++)
+    {
+        FractalRenderer *renderer = views[i].renderer;
+        if (renderer->params.viewMode == FRACTAL_VIEW_QUATERNION)
+            continue;
+        if (bound != renderer->programs->classic)
+            glUseProgram(bound = renderer->programs->classic);
+        renderer->drawClassic(views[i]);
+    }
+
+    bool quaternionViews = false;
+    for (int i = 0; i < count; i++)
+    {
+        FractalRenderer *renderer = views[i].renderer;
+        if (renderer->params.viewMode != FRACTAL_VIEW_QUATERNION)
+            continue;
+        if (bound != renderer->programs->cone)
+            glUseProgram(bound = renderer->programs->cone);
+        renderer->drawCone(views[i]);
+        quaternionViews = true;
+    }
+    if (!quaternionViews)
+        return;
+    for (int i = 0; i < count; i++)
+    {
+        FractalRenderer *renderer = views[i].renderer;
+        if (renderer->params.viewMode != FRACTAL_VIEW_QUATERNION)
+            continue;
+        if (bound != renderer->programs->quaternion)
+            glUseProgram(bound = renderer->programs->quaternion);
+        renderer->drawQuaternion(views[i]);
+    }
+}
+
+void FractalRenderer::drawClassic(const View &view)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, view.framebuffer);
+    glViewport(0, 0, view.width, view.height);
+    setUniforms(programs->classicUniforms, params, view.width, view.height);
+
+    bool video = params.videoAmount > 0.0f && videoTextures[0];
+    glUniform1f(programs->videoAmountLocation, video ? params.videoAmount : 0.0f);
+    if (video)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            glActiveTexture(GL_TEXTURE1 + i);
+            glBindTexture(GL_TEXTURE_2D, videoTextures[i]);
+        }
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    glBindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+}
+
+// Düşük çözünürlükte koni geçişi: piksel başına raymarch için başlangıç uzaklığı
+void FractalRenderer::drawCone(const View &view)
+{
+    int width = (view.width + FRACTAL_CONE_DOWNSAMPLE - 1) / FRACTAL_CONE_DOWNSAMPLE;
+    int height = (view.height + FRACTAL_CONE_DOWNSAMPLE - 1) / FRACTAL_CONE_DOWNSAMPLE;
+    if (width != coneWidth || height != coneHeight)
+    {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, coneTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, width, height, 0, GL_RED, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, coneFramebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, coneTexture, 0);
+        coneWidth = width;
+        coneHeight = height;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, coneFramebuffer);
+    glViewport(0, 0, coneWidth, coneHeight);
+    // Koni geçişi de tam çözünürlüğün kamerasını kullanır
+    setUniforms(programs->coneUniforms, params, view.width, view.height);
+    glBindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+}
+
+void FractalRenderer::drawQuaternion(const View &view)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, view.framebuffer);
+    glViewport(0, 0, view.width, view.height);
+    setUniforms(programs->quaternionUniforms, params, view.width, view.height);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, coneTexture);
+    glBindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+}
+
+// Hedefi RGBA8 olarak oku (alt satır önce)
+bool FractalRenderer::readPixels(void *rgba, size_t size) const
+{
+    if (!targetFramebuffer || targetWidth <= 0 || size < (size_t)targetWidth * targetHeight * 4)
+        return false;
+    glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, targetWidth, targetHeight, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return true;
+}
+
+// C ABI: tutamaç doğrudan FractalRenderer nesnesidir
+static FractalRenderer *fromHandle(FractalRendererHandle *renderer)
+{
+    return reinterpret_cast<FractalRenderer *>(renderer);
+}
+
+static const FractalRenderer *fromHandle(const FractalRendererHandle *renderer)
+{
+    return reinterpret_cast<const FractalRenderer *>(renderer);
+}
+
+int fractal_renderer_abi_version(void)
+{
+    return FRACTAL_RENDERER_ABI_VERSION;
+}
+
+void fractal_default_params(FractalParams *params)
+{
+    params->zoom = 2.5f;
+    params->offsetX = 0.0f;
+    params->offsetY = 0.0f;
+    params->juliaX = -0.4f;
+    params->juliaY = 0.6f;
+    params->time = 0.0f;
+    params->colorMode = 0;
+    params->complexity = 1.0f;
+    params->viewMode = FRACTAL_VIEW_CLASSIC;
+    params->videoAmount = 0.0f;
+}
+
+FractalRendererHandle *fractal_renderer_create(int width, int height)
+{
+    FractalRenderer *renderer = new (std::nothrow) FractalRenderer();
+    if (!renderer)
+        return nullptr;
+    if (!renderer->init(width, height))
+    {
+        renderer->destroy();
+        delete renderer;
+        return nullptr;
+    }
+    return reinterpret_cast<FractalRendererHandle *>(renderer);
+}
+
+void fractal_renderer_destroy(FractalRendererHandle *renderer)
+{
+    if (!renderer)
+        return;
+    fromHandle(renderer)->destroy();
+    delete fromHandle(renderer);
+}
+
+void fractal_renderer_set_params(FractalRendererHandle *renderer, const FractalParams *params)
+{
+    fromHandle(renderer)->setParams(*params);
+}
+
+void fractal_renderer_get_params(const FractalRendererHandle *renderer, FractalParams *params)
+{
+    *params = fromHandle(renderer)->getParams();
+}
+
+void fractal_renderer_set_video_textures(FractalRendererHandle *renderer, uint32_t y, uint32_t u, uint32_t v)
+{
+    fromHandle(renderer)->setVideoTextures(y, u, v);
+}
+
+int fractal_renderer_resize(FractalRendererHandle *renderer, int width, int height)
+{
+    return fromHandle(renderer)->resize(width, height) ? 1 : 0;
+}
+
+uint32_t fractal_renderer_texture(const FractalRendererHandle *renderer)
+{
+    return fromHandle(renderer)->texture();
+}
+
+void fractal_renderer_render(FractalRendererHandle *renderer)
+{
+    fromHandle(renderer)->render();
+}
+
+void fractal_renderer_render_batch(FractalRendererHandle *const *renderers, int count)
+{
+    FractalRenderer::renderBatch(reinterpret_cast<FractalRenderer *const *>(renderers), count);
+}
+
+int fractal_renderer_read_pixels(const FractalRendererHandle *renderer, void *rgba, size_t size)
+{
+    return fromHandle(renderer)->readPixels(rgba, size) ? 1 : 0;
+}
@@ -0,0 +1,177 @@
+#ifndef FRACTAL_RENDERER_H
+#define FRACTAL_RENDERER_H
+
+// Gömülebilir fraktal renderer
+//
+// Her FractalRenderer kendi VAO'suna, parametrelerine ve ekran dışı hedef
+// dokusuna sahiptir; derlenmiş shader programları ise aynı GL context'indeki
+// örnekler arasında paylaşılır ve o context'in son örneğiyle birlikte silinir.
+// Böylece tek bir süreç birden fazla görünümü (ekran, iş) çizebilir; her
+// ekran için ayrı bir context kullanılıyorsa her context kendi programlarını
+// derler.
+//
+// VAO ve framebuffer'lar context'ler arasında paylaşılmadığından, destroy
+// dahil tüm çağrılar örneğin oluşturulduğu context aktifken ve GLEW
+// başlatıldıktan sonra yapılmalıdır. Context WGL, GLX ya da EGL üzerinden
+// tanınır. Çağrılar program, VAO, framebuffer, viewport ve 0-3 numaralı doku
+// birimlerinin bağlamalarını değiştirir.
+//
+// C ABI'si yalnızca opak tutamaç, düz C yapıları ve temel tipler kullanır;
+// uyumluluğu bozan her değişiklikte FRACTAL_RENDERER_ABI_VERSION artırılır.
+// Paylaşılan kütüphane olarak derlerken FRACTAL_RENDERER_SHARED ve
+// FRACTAL_RENDERER_BUILD tanımlanmalıdır.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FRACTAL_RENDERER_ABI_VERSION 1
+
+#if defined(FRACTAL_RENDERER_SHARED) && defined(_WIN32)
+#ifdef FRACTAL_RENDERER_BUILD
+#define FRACTAL_API __declspec(dllexport)
+#else
+#define FRACTAL_API __declspec(dllimport)
+#endif
+#elif defined(FRACTAL_RENDERER_SHARED) && defined(__GNUC__)
+#define FRACTAL_API __attribute__((visibility("default")))
+#else
+#define FRACTAL_API
+#endif
+
+// Koni ön geçişinde bir pikselin kapladığı blok kenarı (CPU yolu da kullanır)
+#define FRACTAL_CONE_DOWNSAMPLE 8
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Görünüm türleri
+    enum
+    {
+        FRACTAL_VIEW_CLASSIC = 0,   // Animasyonlu, distorsiyonlu 2D julia
+        FRACTAL_VIEW_QUATERNION = 1 // Raymarch edilen 3D quaternion julia
+    };
+
+    // Bir görünümün tüm parametreleri
+    typedef struct FractalParams
+    {
+        float zoom;
+        float offsetX;
+        float offsetY;
+        float juliaX;
+        float juliaY;
+        float time;
+        int32_t colorMode;
+        float complexity;
+        int32_t viewMode;  // FRACTAL_VIEW_*
+        float videoAmount; // 0 = video kapalı (yalnızca klasik görünüm)
+    } FractalParams;
+
+    typedef struct FractalRendererHandle FractalRendererHandle;
+
+    FRACTAL_API int fractal_renderer_abi_version(void);
+    FRACTAL_API void fractal_default_params(FractalParams *params);
+
+    // Ekran dışı hedefi width x height olan bir renderer oluştur; programlar
+    // derlenemezse NULL döner
+    FRACTAL_API FractalRendererHandle *fractal_renderer_create(int width, int height);
+    FRACTAL_API void fractal_renderer_destroy(FractalRendererHandle *renderer);
+
+    FRACTAL_API void fractal_renderer_set_params(FractalRendererHandle *renderer, const FractalParams *params);
+    FRACTAL_API void fractal_renderer_get_params(const FractalRendererHandle *renderer, FractalParams *params);
+    // Video düzlemleri: YUV 4:2:0, her düzlem ayrı R8 doku (0 = yok)
+    FRACTAL_API void fractal_renderer_set_video_textures(FractalRendererHandle *renderer,
+                                                         uint32_t y, uint32_t u, uint32_t v);
+
+    FRACTAL_API int fractal_renderer_resize(FractalRendererHandle *renderer, int width, int height);
+    // Hedefin RGBA8 GL dokusu
+    FRACTAL_API uint32_t fractal_renderer_texture(const FractalRendererHandle *renderer);
+
+    FRACTAL_API void fractal_renderer_render(FractalRendererHandle *renderer);
+    // Birbirinden bağımsız görünümleri tek gönderimde kendi hedeflerine çiz
+    FRACTAL_API void fractal_renderer_render_batch(FractalRendererHandle *const *renderers, int count);
+
+    // Hedefi RGBA8 olarak oku (alt satır önce); size en az width * height * 4 olmalı
+    FRACTAL_API int fractal_renderer_read_pixels(const FractalRendererHandle *renderer, void *rgba, size_t size);
+
+#ifdef __cplusplus
+}
+
+#include <GL/glew.h>
+
+// Program derleme seçenekleri; ilk renderer oluşturulmadan önce ayarlanmalı
+struct FractalShaderOptions
+{
+    bool telemetryCounters = false; // GL 4.3 SSBO sayaçları (binding 0)
+    int telemetryStride = 8;        // Sayılan piksel bloğunun kenarı
+    void (*onProgramCompiled)(const char *name, int64_t durationNs) = nullptr;
+};
+
+void setFractalShaderOptions(const FractalShaderOptions &options);
+
+// Ortak başlığı (paletler, julia iterasyonu, renklendirme) kullanan ek
+// programlar için yardımcılar
+extern const char *fractalVertexShaderSource;
+GLuint createFractalProgram(const char *name, const char *vertexSource, const char *fragmentBody);
+void createFractalQuad(GLuint &vao, GLuint &vbo);
+
+struct FractalPrograms;
+
+class FractalRenderer
+{
+public:
+    FractalRenderer();
+    // GL nesnelerine ve program referansına sahip olduğu için kopyalanamaz
+    FractalRenderer(const FractalRenderer &) = delete;
+    FractalRenderer &operator=(const FractalRenderer &) = delete;
+
+    // GL nesnelerini oluştur; hedef boyutu 0 ise yalnızca renderTo kullanılabilir
+    bool init(int width = 0, int height = 0);
+    void destroy();
+
+    void setParams(const FractalParams &newParams) { params = newParams; }
+    const FractalParams &getParams() const { return params; }
+    void setVideoTextures(GLuint y, GLuint u, GLuint v);
+
+    bool resize(int width, int height);
+    GLuint texture() const { return targetTexture; }
+    int width() const { return targetWidth; }
+    int height() const { return targetHeight; }
+
+    // Kendi hedefine çiz
+    void render();
+    // Verilen framebuffer'a (0 = pencere) çiz
+    void renderTo(GLuint framebuffer, int width, int height);
+    // Görünümleri programa göre gruplayıp tek gönderimde çiz (hepsi aktif
+    // context'te oluşturulmuş olmalı)
+    static void renderBatch(FractalRenderer *const *renderers, int count);
+
+    bool readPixels(void *rgba, size_t size) const;
+
+private:
+    struct View
+    {
+        FractalRenderer *renderer;
+        GLuint framebuffer;
+        int width;
+        int height;
+    };
+
+    static void drawViews(const View *views, int count);
+    void drawClassic(const View &view);
+    void drawCone(const View &view);
+    void drawQuaternion(const View &view);
+
+    FractalPrograms *programs = nullptr;
+    FractalParams params;
+    GLuint quadVAO = 0, quadVBO = 0;
+    GLuint targetFramebuffer = 0, targetTexture = 0;
+    int targetWidth = 0, targetHeight = 0;
+    GLuint coneFramebuffer = 0, coneTexture = 0;
+    int coneWidth = 0, coneHeight = 0;
+    GLuint videoTextures[3] = {};
+};
+#endif
+
+#endif
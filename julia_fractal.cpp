@@ -1,27 +1,57 @@
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+extern char **environ;
+#endif
 #include <GL/glew.h>
+#ifndef _WIN32
+#include <GL/glxew.h>
+#include <X11/Xlib.h>
+#endif
 #include <GL/freeglut.h>
+#include "fractal_renderer.h"
 #include <complex>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <vector>
 #include <string>
 #include <iostream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <list>
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+#include <cerrno>
+#include <functional>
 
 // Pencere boyutları - 4K destekli
 const int WIDTH = 1920;
 const int HEIGHT = 1080;
 
-// Shader programı
-GLuint shaderProgram;
-GLuint quadVAO, quadVBO;
-
-// Uniform lokasyonları
-GLint timeLocation;
-GLint resolutionLocation;
-GLint zoomLocation;
-GLint offsetLocation;
-GLint juliaParamLocation;
-GLint modeLocation;
-GLint complexityLocation;
+// Pencere görünümünü çizen renderer (render thread'inde başlatılır)
+FractalRenderer mainRenderer;
+GLuint quadVAO, quadVBO; // Tile geçişlerinin quad'ı
 
 // Fraktal parametreleri
 float zoom = 2.5f;
@@ -34,318 +64,2488 @@ bool autoRotate = true;
 float rotationSpeed = 0.0003f;
 int colorMode = 0;       // Farklı renk paletleri için
 float complexity = 1.0f; // Karmaşıklık seviyesi
+// Görünüm modları
+enum ViewMode
+{
+    VIEW_CLASSIC,   // Animasyonlu, distorsiyonlu 2D julia
+    VIEW_TILES,     // Önbellekli tile keşif modu
+    VIEW_QUATERNION // Raymarch edilen 3D quaternion julia
+};
+int viewMode = VIEW_CLASSIC;
+bool videoEffect = true; // --video ile verilen videonun fraktale etkisi
+int viewportWidth = WIDTH;
+int viewportHeight = HEIGHT;
+
+// Yukarıdaki parametreler yalnızca input (GLUT) thread'inde değişir.
+// Render thread'i bunlara hiç dokunmaz; her değişiklikten sonra değişmez bir
+// kopya (FrameParams) triple buffer üzerinden yayınlanır.
+struct FrameParams
+{
+    float zoom;
+    float offsetX;
+    float offsetY;
+    float juliaX;
+    float juliaY;
+    float time;
+    int colorMode;
+    float complexity;
+    int viewMode;
+    float videoAmount;
+    int viewportWidth;
+    int viewportHeight;
+    int64_t inputTimeNs; // Henüz ekrana yansımamış en eski girdi olayı (0 = yok)
+};
+
+// Tek yazıcı / tek okuyucu kilitsiz triple buffer. Yazıcı kendi tamponunu
+// doldurup publish() ile ortadaki tamponla takas eder; okuyucu update() ile
+// en son yayınlanan tamponu alır. Aradaki yayınlar birleştirilir (coalesce),
+// hiçbir tampon aynı anda iki thread tarafından yazılıp okunmaz.
+template <typename T>
+class TripleBuffer
+{
+public:
+    T &writeBuffer() { return buffers[writeIndex]; }
+
+    void publish()
+    {
+        writeIndex = state.exchange(writeIndex | DIRTY, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Yeni bir görüntü alındıysa true döner
+    bool update()
+    {
+        if (!(state.load(std::memory_order_relaxed) & DIRTY))
+            return false;
+        readIndex = state.exchange(readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    const T &readBuffer() const { return buffers[readIndex]; }
+
+private:
+    static const unsigned DIRTY = 4;
+    static const unsigned INDEX_MASK = 3;
+    T buffers[3] = {};
+    std::atomic<unsigned> state{1};
+    unsigned writeIndex = 0;
+    unsigned readIndex = 2;
+};
+
+TripleBuffer<FrameParams> frameParams;
+
+// Girdi gecikmesi (input-to-photon) ölçümü
+int64_t pendingInputNs = 0;               // Input thread: birleştirilmiş olayların en eskisi
+std::atomic<int64_t> consumedInputNs{0};  // Render thread: çizime alınan son olay
+std::atomic<uint64_t> latencySamples{0};
+std::atomic<uint64_t> latencyTotalNs{0};
+std::atomic<uint64_t> latencyMaxNs{0};
+std::atomic<uint64_t> latencyLastNs{0};
+
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Render thread ve GL context'i
+//
+// freeglut her callback'ten önce kendi context'ini GLUT thread'inde yeniden
+// aktif eder; bu yüzden render thread'i GLUT'un context'ini devralmaz, aynı
+// pencereye çizen ve nesneleri onunla paylaşan kendi context'ini kullanır.
+std::thread renderThread;
+std::atomic<bool> renderStop{false};
+
+#ifdef _WIN32
+struct GLContextHandle
+{
+    HDC dc;
+    HGLRC rc;
+};
+
+// GLUT thread'inde, GLUT'un context'i aktifken çağrılır
+GLContextHandle createSharedContext()
+{
+    GLContextHandle ctx = {wglGetCurrentDC(), NULL};
+    ctx.rc = wglCreateContext(ctx.dc);
+    if (ctx.rc && !wglShareLists(wglGetCurrentContext(), ctx.rc))
+    {
+        wglDeleteContext(ctx.rc);
+        ctx.rc = NULL;
+    }
+    return ctx;
+}
+void destroyContext(const GLContextHandle &ctx)
+{
+    if (ctx.rc)
+        wglDeleteContext(ctx.rc);
+}
+void releaseCurrentContext(const GLContextHandle &) { wglMakeCurrent(NULL, NULL); }
+bool makeContextCurrent(const GLContextHandle &ctx) { return ctx.rc && wglMakeCurrent(ctx.dc, ctx.rc); }
+void swapContextBuffers(const GLContextHandle &ctx) { SwapBuffers(ctx.dc); }
+#else
+struct GLContextHandle
+{
+    Display *display;
+    GLXDrawable drawable;
+    GLXContext context;
+};
+
+int ignoreXError(Display *, XErrorEvent *) { return 0; }
+
+// GLUT thread'inde, GLUT'un context'i aktifken çağrılır. Yeni context aynı
+// FBConfig'ten ve aynı GL sürümü/profiliyle oluşturulur.
+GLContextHandle createSharedContext()
+{
+    GLContextHandle ctx = {glXGetCurrentDisplay(), glXGetCurrentDrawable(), NULL};
+    GLXContext shared = glXGetCurrentContext();
+    int configId = 0;
+    glXQueryContext(ctx.display, shared, GLX_FBCONFIG_ID, &configId);
+    int configAttribs[] = {GLX_FBCONFIG_ID, configId, None};
+    int configCount = 0;
+    GLXFBConfig *configs = glXChooseFBConfig(ctx.display, DefaultScreen(ctx.display), configAttribs, &configCount);
+    if (!configs || configCount == 0)
+        return ctx;
+
+    // Desteklenmeyen öznitelikler X hatası üretir; varsayılan işleyici süreci
+    // sonlandırmasın, başarısızlıkta eski yola düşülsün
+    XSync(ctx.display, False);
+    XErrorHandler previousHandler = XSetErrorHandler(ignoreXError);
+    if (GLXEW_ARB_create_context)
+    {
+        GLint major = 0, minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        // GLUT varsayılan olarak uyumluluk profili açar; 3.2 öncesinde profil
+        // özniteliği yok (0 listeyi orada bitirir)
+        bool profile = GLXEW_ARB_create_context_profile && (major > 3 || (major == 3 && minor >= 2));
+        int attribs[] = {GLX_CONTEXT_MAJOR_VERSION_ARB, major,
+                         GLX_CONTEXT_MINOR_VERSION_ARB, minor,
+                         profile ? GLX_CONTEXT_PROFILE_MASK_ARB : 0,
+                         GLX_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB,
+                         None};
+        ctx.context = glXCreateContextAttribsARB(ctx.display, configs[0], shared, True, attribs);
+        XSync(ctx.display, False);
+    }
+    if (!ctx.context)
+        ctx.context = glXCreateNewContext(ctx.display, configs[0], GLX_RGBA_TYPE, shared, True);
+    XSync(ctx.display, False);
+    XSetErrorHandler(previousHandler);
+    XFree(configs);
+    return ctx;
+}
+void destroyContext(const GLContextHandle &ctx)
+{
+    if (ctx.context)
+        glXDestroyContext(ctx.display, ctx.context);
+}
+void releaseCurrentContext(const GLContextHandle &ctx) { glXMakeCurrent(ctx.display, None, NULL); }
+bool makeContextCurrent(const GLContextHandle &ctx) { return ctx.context && glXMakeCurrent(ctx.display, ctx.drawable, ctx.context); }
+void swapContextBuffers(const GLContextHandle &ctx) { glXSwapBuffers(ctx.display, ctx.drawable); }
+#endif
+
+GLContextHandle glContext; // Render thread'inin context'i
+
+// Telemetri
+//
+// Render thread her kare için bir FrameSample üretip kilitsiz halkaya yazar;
+// telemetri thread'i halkayı boşaltıp toplamları Unix soketi üzerinden
+// Prometheus metin formatında sunar. Render thread'i hiçbir zaman beklemez:
+// halka doluysa örnek atılır ve sayılır.
+const int TELEMETRY_SLOTS = 4;  // Uçuştaki GPU sorgu/sayaç tamponu sayısı
+const int TELEMETRY_STRIDE = 8; // Shader sayaçları 8x8 pikselde bir örnekler
+const int MAX_SHADER_PROGRAMS = 16;
+
+struct FrameSample
+{
+    int64_t cpuFrameNs; // Çizim + swap'ın CPU süresi
+    int64_t intervalNs; // Bir önceki swap'tan bu yana geçen süre (0 = ilk kare)
+    int64_t gpuTimeNs;  // Tamamlanmış bir önceki karenin GPU süresi (-1 = yok)
+    uint32_t iterations; // Örneklenmiş shader sayaçları (gpuTimeNs ile aynı kare)
+    uint32_t escaped;
+    uint32_t interior;
+};
+
+// Tek yazıcı / tek okuyucu kilitsiz halka
+template <typename T, size_t N>
+class SpscRing
+{
+public:
+    bool push(const T &item)
+    {
+        size_t head = writePos.load(std::memory_order_relaxed);
+        if (head - readPos.load(std::memory_order_acquire) == N)
+            return false;
+        items[head % N] = item;
+        writePos.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &item)
+    {
+        size_t tail = readPos.load(std::memory_order_relaxed);
+        if (tail == writePos.load(std::memory_order_acquire))
+            return false;
+        item = items[tail % N];
+        readPos.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T items[N];
+    std::atomic<size_t> writePos{0};
+    std::atomic<size_t> readPos{0};
+};
+
+SpscRing<FrameSample, 1024> telemetryRing;
+std::atomic<uint64_t> telemetryDropped{0};
+bool gpuCountersEnabled = false; // GL 4.3 (SSBO atomikleri) varsa açılır
+
+// Program derleme süreleri: yalnızca render thread'i yazar, slot bir kez doldurulur
+struct ShaderCompileStat
+{
+    const char *name;
+    std::atomic<int64_t> durationNs{0};
+};
+ShaderCompileStat shaderCompileStats[MAX_SHADER_PROGRAMS];
+std::atomic<int> shaderCompileCount{0};
+
+void recordShaderCompile(const char *name, int64_t durationNs)
+{
+    int slot = shaderCompileCount.load(std::memory_order_relaxed);
+    if (slot >= MAX_SHADER_PROGRAMS)
+        return;
+    shaderCompileStats[slot].name = name;
+    shaderCompileStats[slot].durationNs.store(durationNs, std::memory_order_relaxed);
+    shaderCompileCount.store(slot + 1, std::memory_order_release);
+}
+
+// Tile programları renderer kütüphanesinin ortak başlığıyla (paletler,
+// juliaEscape, shadeJulia) derlenir.
+
+// Tile alanı: distorsiyonsuz düzlemde kaçış süresini R32F dokuya yazar.
+// Zamandan bağımsız olduğu için önbelleğe alınabilir.
+const char *tileFieldShaderSource = R"(
+    out float FieldValue;
+    
+    uniform vec2 tileOrigin;
+    uniform float tileSize;
+    uniform float tilePixels;
+    uniform vec2 juliaParam;
+    
+    void main() {
+        vec2 z = tileOrigin + gl_FragCoord.xy / tilePixels * tileSize;
+        FieldValue = juliaEscape(z, juliaParam);
+        recordTelemetry(FieldValue);
+    }
+)";
+
+// Tile vertex shader: tam ekran quad'ı tile'ın ekrandaki dikdörtgenine yerleştirir
+const char *tileVertexShaderSource = R"(
+    #version 330 core
+    layout (location = 0) in vec3 aPos;
+    layout (location = 1) in vec2 aTexCoord;
+    uniform vec4 screenRect; // NDC: x0, y0, x1, y1
+    uniform vec4 fieldRect;  // Doku koordinatı: u0, v0, u1, v1
+    out vec2 TexCoord;
+    void main() {
+        gl_Position = vec4(mix(screenRect.xy, screenRect.zw, aTexCoord), 0.0, 1.0);
+        TexCoord = mix(fieldRect.xy, fieldRect.zw, aTexCoord);
+    }
+)";
+
+// Tile kompozisyonu: önbellekteki alanı her karede paletle renklendirir
+const char *tileComposeShaderSource = R"(
+    out vec4 FragColor;
+    in vec2 TexCoord;
+    
+    uniform sampler2D field;
+    
+    void main() {
+        vec2 originalUV = (gl_FragCoord.xy - 0.5 * resolution.xy) / min(resolution.x, resolution.y);
+        FragColor = vec4(shadeJulia(texture(field, TexCoord).r, originalUV), 1.0);
+    }
+)";
+
+// Quadtree tile önbelleği (keşif modu)
+//
+// Keşif modunda görüntü, distorsiyonsuz düzlemin kaçış süresi alanını tutan
+// TILE_PIXELS x TILE_PIXELS tile'lardan birleştirilir. Seviye 0 tile'ı
+// [-4, 4]^2 karesini kaplar, her seviye kenarı yarıya böler. Alan zamandan
+// bağımsız olduğundan tile'lar (seviye, x, y, julia parametresi) ile
+// anahtarlanıp yeniden kullanılır; palet ve efektler kompozisyonda uygulanır.
+const int TILE_PIXELS = 256;
+const double TILE_ROOT_SIZE = 8.0;
+// Alan float ile hesaplanır: seviye 17'de piksel aralığı 2^-22, yani |z| < 4
+// bölgesinde en az bir ulp. Daha derinde komşu pikseller aynı noktaya düşer;
+// bu yüzden daha derin zoom'da en derin seviye büyütülerek gösterilir.
+const int TILE_MAX_LEVEL = 17;
+const size_t TILE_CACHE_CAPACITY = 384; // ~96 MB R32F doku (bu karenin tile'ları sığmazsa aşılır)
+const int TILE_RENDER_BUDGET = 8;       // Kare başına GPU'da üretilen en fazla tile
+const int TILE_DISK_BUDGET = 32;        // Kare başına istenen en fazla disk yüklemesi
+const int TILE_READBACK_SLOTS = 3 * TILE_RENDER_BUDGET; // Diske yazma için PBO sayısı
+const size_t TILE_LOOKUP_LIMIT = 4096;  // Hatırlanan "diskte yok" sonucu sayısı
+const int TILE_FALLBACK_LEVELS = 8;     // Eksik tile için aranacak üst seviye sayısı
+const uint32_t TILE_FILE_MAGIC = 0x314C544A; // "JTL1"
+
+struct TileKey
+{
+    int level;
+    int64_t x;
+    int64_t y;
+    uint32_t juliaXBits;
+    uint32_t juliaYBits;
+
+    bool operator==(const TileKey &other) const
+    {
+        return level == other.level && x == other.x && y == other.y &&
+               juliaXBits == other.juliaXBits && juliaYBits == other.juliaYBits;
+    }
+};
+
+struct TileKeyHash
+{
+    size_t operator()(const TileKey &key) const
+    {
+        uint64_t fields[] = {(uint64_t)key.level, (uint64_t)key.x, (uint64_t)key.y,
+                             key.juliaXBits, key.juliaYBits};
+        uint64_t hash = 1469598103934665603ull;
+        for (uint64_t field : fields)
+        {
+            hash ^= field;
+            hash *= 1099511628211ull;
+        }
+        return (size_t)hash;
+    }
+};
+
+uint32_t floatBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Bellek içi LRU önbellek. Dokular yalnızca render thread'inde oluşturulur ve
+// silinir; kapasite dolunca en eski tile'ın dokusu yeni tile için yeniden kullanılır.
+// Bu karede kullanılan tile'lar sabitlenir: ekranda birleştirilecek bir doku
+// hiçbir zaman üzerine yazılmaz, gerekirse önbellek geçici olarak büyür ve
+// sonraki eklemelerde kapasiteye geri döner.
+class TileCache
+{
+public:
+    // Kare başında çağrılır; önceki karenin sabitlemelerini kaldırır
+    void beginFrame() { frame++; }
+
+    // Tile'ın dokusunu döndürür (yoksa 0) ve onu en yeni kullanılan yapar
+    GLuint find(const TileKey &key)
+    {
+        auto it = entries.find(key);
+        if (it == entries.end())
+            return 0;
+        lru.splice(lru.begin(), lru, it->second.lruPos);
+        it->second.frame = frame;
+        return it->second.texture;
+    }
+
+    // Yeni tile için doku ayır
+    GLuint insert(const TileKey &key)
+    {
+        GLuint texture = 0;
+        // Sabitlenmiş tile'lar listenin başında; sondaki sabitse hepsi sabittir
+        while (entries.size() >= TILE_CACHE_CAPACITY)
+        {
+            auto oldest = entries.find(lru.back());
+            if (oldest->second.frame == frame)
+                break;
+            if (texture)
+                glDeleteTextures(1, &texture); // Kapasitenin üstündeki doku
+            texture = oldest->second.texture;
+            entries.erase(oldest);
+            lru.pop_back();
+        }
+        if (!texture)
+            texture = createFieldTexture();
+        lru.push_front(key);
+        entries[key] = {texture, lru.begin(), frame};
+        return texture;
+    }
+
+    void clear()
+    {
+        for (auto &entry : entries)
+            glDeleteTextures(1, &entry.second.texture);
+        entries.clear();
+        lru.clear();
+    }
+
+private:
+    struct Entry
+    {
+        GLuint texture;
+        std::list<TileKey>::iterator lruPos;
+        uint64_t frame; // Son kullanıldığı kare
+    };
+
+    GLuint createFieldTexture()
+    {
+        GLuint texture;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, TILE_PIXELS, TILE_PIXELS, 0, GL_RED, GL_FLOAT, NULL);
+        // Kaçış süresi iç bölge işaretiyle süreksiz; enterpolasyon yapılmamalı
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        return texture;
+    }
+
+    std::list<TileKey> lru; // Baş: en yeni kullanılan
+    std::unordered_map<TileKey, Entry, TileKeyHash> entries;
+    uint64_t frame = 0;
+};
+
+// Diskten yüklenen (ya da diskte bulunamayan) tile
+struct TileLoad
+{
+    TileKey key;
+    bool found;
+    std::vector<float> data;
+};
+
+// İsteğe bağlı disk önbelleği: tile'ları çalıştırmalar arasında saklar.
+// Okuma ve yazma ayrı bir thread'de yapılır, render thread'i diski beklemez:
+// yüklemeler istenir ve sonraki karelerde collectLoads ile alınır.
+class TileDiskCache
+{
+public:
+    bool open(const std::string &dir)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        if (ec)
+        {
+            std::cerr << "Tile cache directory error: " << ec.message() << std::endl;
+            return false;
+        }
+        directory = dir;
+        stopping = false;
+        worker = std::thread(&TileDiskCache::workerLoop, this);
+        return true;
+    }
+
+    bool enabled() const { return !directory.empty(); }
+
+    void requestLoad(const TileKey &key)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            loadQueue.push_back(key);
+        }
+        wake.notify_one();
+    }
+
+    // Tamamlanan yüklemeleri al
+    void collectLoads(std::vector<TileLoad> &done)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (TileLoad &load : loaded)
+            done.push_back(std::move(load));
+        loaded.clear();
+    }
+
+    void store(const TileKey &key, std::vector<float> data)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            storeQueue.emplace_back(key, std::move(data));
+        }
+        wake.notify_one();
+    }
+
+    // Bekleyen yazmaları bitir ve thread'i kapat
+    void close()
+    {
+        if (!worker.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            loadQueue.clear();
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+private:
+    std::string pathFor(const TileKey &key) const
+    {
+        char name[128];
+        snprintf(name, sizeof(name), "%d_%lld_%lld_%08x_%08x.tile", key.level, (long long)key.x,
+                 (long long)key.y, key.juliaXBits, key.juliaYBits);
+        return (std::filesystem::path(directory) / name).string();
+    }
+
+    bool load(const TileKey &key, std::vector<float> &data) const
+    {
+        std::ifstream file(pathFor(key), std::ios::binary);
+        if (!file)
+            return false;
+        uint32_t magic = 0;
+        file.read((char *)&magic, sizeof(magic));
+        data.resize(TILE_PIXELS * TILE_PIXELS);
+        file.read((char *)data.data(), data.size() * sizeof(float));
+        return magic == TILE_FILE_MAGIC && file.gcount() == (std::streamsize)(data.size() * sizeof(float));
+    }
+
+    void write(const TileKey &key, const std::vector<float> &data)
+    {
+        // Yarım kalmış dosya okunmasın diye geçici dosyaya yazıp taşı
+        std::string path = pathFor(key);
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary);
+            file.write((const char *)&TILE_FILE_MAGIC, sizeof(TILE_FILE_MAGIC));
+            file.write((const char *)data.data(), data.size() * sizeof(float));
+        }
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+    }
+
+    // Yüklemeler ekranda beklenen tile'lar için; yazmalardan önce yapılır
+    void workerLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            wake.wait(lock, [this] { return stopping || !loadQueue.empty() || !storeQueue.empty(); });
+            if (!loadQueue.empty())
+            {
+                TileLoad load;
+                load.key = loadQueue.front();
+                loadQueue.pop_front();
+                lock.unlock();
+                load.found = this->load(load.key, load.data);
+                lock.lock();
+                loaded.push_back(std::move(load));
+                continue;
+            }
+            if (storeQueue.empty())
+                return;
+            auto item = std::move(storeQueue.front());
+            storeQueue.pop_front();
+            lock.unlock();
+            write(item.first, item.second);
+            lock.lock();
+        }
+    }
+
+    std::string directory;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<TileKey> loadQueue;
+    std::vector<TileLoad> loaded;
+    std::deque<std::pair<TileKey, std::vector<float>>> storeQueue;
+    bool stopping = false;
+};
+
+// Diske yazılacak tile'lar PBO'lara asenkron okunur; fence sinyallendiğinde
+// veriler disk thread'ine verilir. Boş slot yoksa tile yalnızca bellekte kalır.
+class TileReadback
+{
+public:
+    void init()
+    {
+        glGenBuffers(TILE_READBACK_SLOTS, buffers);
+        for (GLuint buffer : buffers)
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+            glBufferData(GL_PIXEL_PACK_BUFFER, TILE_PIXELS * TILE_PIXELS * sizeof(float), NULL, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    void destroy()
+    {
+        for (GLsync &fence : fences)
+        {
+            if (fence)
+                glDeleteSync(fence);
+            fence = NULL;
+        }
+        glDeleteBuffers(TILE_READBACK_SLOTS, buffers);
+    }
+
+    // Bağlı framebuffer'daki tile'ın okunmasını başlat
+    bool queue(const TileKey &key)
+    {
+        for (int i = 0; i < TILE_READBACK_SLOTS; i++)
+        {
+            if (fences[i])
+                continue;
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, buffers[i]);
+            glReadPixels(0, 0, TILE_PIXELS, TILE_PIXELS, GL_RED, GL_FLOAT, (void *)0);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            keys[i] = key;
+            return true;
+        }
+        return false;
+    }
+
+    // Biten okumaları disk önbelleğine ver; wait ise bekleyenlerin hepsini bitir
+    void collect(TileDiskCache &disk, bool wait)
+    {
+        for (int i = 0; i < TILE_READBACK_SLOTS; i++)
+        {
+            if (!fences[i])
+                continue;
+            GLenum status = glClientWaitSync(fences[i], wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                              wait ? 1000000000ull : 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+                continue;
+            glDeleteSync(fences[i]);
+            fences[i] = NULL;
+
+            std::vector<float> data(TILE_PIXELS * TILE_PIXELS);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, buffers[i]);
+            const void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, data.size() * sizeof(float), GL_MAP_READ_BIT);
+            if (mapped)
+            {
+                std::memcpy(data.data(), mapped, data.size() * sizeof(float));
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                disk.store(keys[i], std::move(data));
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+    }
+
+private:
+    GLuint buffers[TILE_READBACK_SLOTS] = {};
+    GLsync fences[TILE_READBACK_SLOTS] = {};
+    TileKey keys[TILE_READBACK_SLOTS] = {};
+};
+
+std::string tileCacheDir; // --tile-cache=DIR ile verilir
+TileCache tileCache;
+TileDiskCache tileDiskCache;
+TileReadback tileReadback;
+// Disk sorguları (render thread'i): true = yükleniyor, false = diskte yok
+std::unordered_map<TileKey, bool, TileKeyHash> tileDiskLookups;
+
+GLuint tileFieldProgram, tileComposeProgram;
+GLuint tileFramebuffer;
+GLint tileOriginLocation, tileSizeLocation, tilePixelsLocation, tileJuliaLocation;
+GLint composeTimeLocation, composeResolutionLocation, composeModeLocation;
+GLint composeScreenRectLocation, composeFieldRectLocation, composeFieldLocation;
+
+void initTiles()
+{
+    tileFieldProgram = createFractalProgram("tile_field", fractalVertexShaderSource, tileFieldShaderSource);
+    tileOriginLocation = glGetUniformLocation(tileFieldProgram, "tileOrigin");
+    tileSizeLocation = glGetUniformLocation(tileFieldProgram, "tileSize");
+    tilePixelsLocation = glGetUniformLocation(tileFieldProgram, "tilePixels");
+    tileJuliaLocation = glGetUniformLocation(tileFieldProgram, "juliaParam");
+
+    tileComposeProgram = createFractalProgram("tile_compose", tileVertexShaderSource, tileComposeShaderSource);
+    composeTimeLocation = glGetUniformLocation(tileComposeProgram, "time");
+    composeResolutionLocation = glGetUniformLocation(tileComposeProgram, "resolution");
+    composeModeLocation = glGetUniformLocation(tileComposeProgram, "mode");
+    composeScreenRectLocation = glGetUniformLocation(tileComposeProgram, "screenRect");
+    composeFieldRectLocation = glGetUniformLocation(tileComposeProgram, "fieldRect");
+    composeFieldLocation = glGetUniformLocation(tileComposeProgram, "field");
+
+    glGenFramebuffers(1, &tileFramebuffer);
+
+    if (!tileCacheDir.empty() && tileDiskCache.open(tileCacheDir))
+    {
+        tileReadback.init();
+        std::cout << "Tile disk cache: " << tileCacheDir << std::endl;
+    }
+}
+
+void destroyTiles()
+{
+    if (tileDiskCache.enabled())
+    {
+        tileReadback.collect(tileDiskCache, true);
+        tileReadback.destroy();
+    }
+    tileDiskCache.close();
+    tileCache.clear();
+    glDeleteFramebuffers(1, &tileFramebuffer);
+    glDeleteProgram(tileFieldProgram);
+    glDeleteProgram(tileComposeProgram);
+}
+
+// Tile'ın kaçış süresi alanını GPU'da dokuya yaz (tileFramebuffer bağlı olmalı)
+void renderTile(const TileKey &key, GLuint texture, float juliaX, float juliaY)
+{
+    double tileSize = std::ldexp(TILE_ROOT_SIZE, -key.level);
+    double origin = -0.5 * TILE_ROOT_SIZE;
+
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    glUniform2f(tileOriginLocation, (float)(origin + key.x * tileSize), (float)(origin + key.y * tileSize));
+    glUniform1f(tileSizeLocation, (float)tileSize);
+    glUniform2f(tileJuliaLocation, juliaX, juliaY);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+
+    if (tileDiskCache.enabled())
+        tileReadback.queue(key);
+}
+
+// Görünümü önbellekteki tile'lardan birleştir. Eksik tile'lar ekran kaplamasına
+// göre sıralanıp kare bütçesi kadarı üretilir, kalanlar için üst seviye tile'ı
+// büyütülerek gösterilir. Eksik tile kaldıysa true döner.
+bool drawTileView(const FrameParams &p)
+{
+    struct VisibleTile
+    {
+        TileKey key;
+        double coverage;
+        float screenRect[4];
+        float fieldRect[4];
+        GLuint texture;
+    };
+
+    // Ekran pikseli <-> düzlem eşlemesi ana shader ile aynı (distorsiyonsuz)
+    double worldPerPixel = 3.0 / (p.zoom * std::min(p.viewportWidth, p.viewportHeight));
+    int level = (int)std::ceil(std::log2(TILE_ROOT_SIZE / (TILE_PIXELS * worldPerPixel)));
+    level = std::max(0, std::min(level, TILE_MAX_LEVEL));
+    double tileSize = std::ldexp(TILE_ROOT_SIZE, -level);
+    double origin = -0.5 * TILE_ROOT_SIZE;
+
+    double worldX0 = p.offsetX - 0.5 * p.viewportWidth * worldPerPixel;
+    double worldY0 = p.offsetY - 0.5 * p.viewportHeight * worldPerPixel;
+    double worldX1 = worldX0 + p.viewportWidth * worldPerPixel;
+    double worldY1 = worldY0 + p.viewportHeight * worldPerPixel;
+
+    int64_t tileX0 = (int64_t)std::floor((worldX0 - origin) / tileSize);
+    int64_t tileY0 = (int64_t)std::floor((worldY0 - origin) / tileSize);
+    int64_t tileX1 = (int64_t)std::floor((worldX1 - origin) / tileSize);
+    int64_t tileY1 = (int64_t)std::floor((worldY1 - origin) / tileSize);
+
+    uint32_t juliaXBits = floatBits(p.juliaX);
+    uint32_t juliaYBits = floatBits(p.juliaY);
+
+    tileCache.beginFrame();
+
+    // Diskten gelen tile'ları önbelleğe aktar, biten okumaları diske ver
+    if (tileDiskCache.enabled())
+    {
+        tileReadback.collect(tileDiskCache, false);
+        std::vector<TileLoad> loads;
+        tileDiskCache.collectLoads(loads);
+        for (TileLoad &load : loads)
+        {
+            if (!load.found)
+            {
+                tileDiskLookups[load.key] = false;
+                continue;
+            }
+            tileDiskLookups.erase(load.key);
+            GLuint texture = tileCache.insert(load.key);
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, TILE_PIXELS, TILE_PIXELS, GL_RED, GL_FLOAT, load.data.data());
+        }
+        // Uzun oturumlarda "diskte yok" sonuçlarını unut; gerekirse yeniden sorulur
+        if (tileDiskLookups.size() > TILE_LOOKUP_LIMIT)
+        {
+            for (auto it = tileDiskLookups.begin(); it != tileDiskLookups.end();)
+                it = it->second ? std::next(it) : tileDiskLookups.erase(it);
+        }
+    }
+
+    std::vector<VisibleTile> tiles;
+    std::vector<size_t> missing;
+    for (int64_t ty = tileY0; ty <= tileY1; ty++)
+    {
+        for (int64_t tx = tileX0; tx <= tileX1; tx++)
+        {
+            VisibleTile tile;
+            tile.key = {level, tx, ty, juliaXBits, juliaYBits};
+
+            // Tile'ın viewport piksellerindeki dikdörtgeni
+            double px0 = (origin + tx * tileSize - worldX0) / worldPerPixel;
+            double py0 = (origin + ty * tileSize - worldY0) / worldPerPixel;
+            double px1 = px0 + tileSize / worldPerPixel;
+            double py1 = py0 + tileSize / worldPerPixel;
+            double visibleW = std::min(px1, (double)p.viewportWidth) - std::max(px0, 0.0);
+            double visibleH = std::min(py1, (double)p.viewportHeight) - std::max(py0, 0.0);
+            tile.coverage = std::max(visibleW, 0.0) * std::max(visibleH, 0.0);
+            tile.screenRect[0] = (float)(px0 / p.viewportWidth * 2.0 - 1.0);
+            tile.screenRect[1] = (float)(py0 / p.viewportHeight * 2.0 - 1.0);
+            tile.screenRect[2] = (float)(px1 / p.viewportWidth * 2.0 - 1.0);
+            tile.screenRect[3] = (float)(py1 / p.viewportHeight * 2.0 - 1.0);
+            tile.fieldRect[0] = 0.0f;
+            tile.fieldRect[1] = 0.0f;
+            tile.fieldRect[2] = 1.0f;
+            tile.fieldRect[3] = 1.0f;
+
+            tile.texture = tileCache.find(tile.key);
+            if (!tile.texture)
+                missing.push_back(tiles.size());
+            tiles.push_back(tile);
+        }
+    }
+
+    // Eksik tile'ları önce diskte ara, yoksa GPU'da üret; ekranı en çok kaplayan önce
+    std::sort(missing.begin(), missing.end(),
+              [&](size_t a, size_t b) { return tiles[a].coverage > tiles[b].coverage; });
+
+    int diskBudget = TILE_DISK_BUDGET;
+    int renderBudget = TILE_RENDER_BUDGET;
+    bool fieldProgramBound = false;
+    size_t unresolved = 0;
+    for (size_t index : missing)
+    {
+        VisibleTile &tile = tiles[index];
+        // Disk yanıtı gelene kadar tile üretilmez, üst seviyesi gösterilir
+        bool canRender = true;
+        if (tileDiskCache.enabled())
+        {
+            auto lookup = tileDiskLookups.find(tile.key);
+            if (lookup == tileDiskLookups.end())
+            {
+                canRender = false;
+                if (diskBudget > 0)
+                {
+                    diskBudget--;
+                    tileDiskLookups[tile.key] = true;
+                    tileDiskCache.requestLoad(tile.key);
+                }
+            }
+            else if (lookup->second)
+            {
+                canRender = false;
+            }
+        }
+        if (canRender && renderBudget > 0)
+        {
+            if (!fieldProgramBound)
+            {
+                glBindFramebuffer(GL_FRAMEBUFFER, tileFramebuffer);
+                glViewport(0, 0, TILE_PIXELS, TILE_PIXELS);
+                glUseProgram(tileFieldProgram);
+                glUniform1f(tilePixelsLocation, (float)TILE_PIXELS);
+                glBindVertexArray(quadVAO);
+                fieldProgramBound = true;
+            }
+            renderBudget--;
+            tile.texture = tileCache.insert(tile.key);
+            renderTile(tile.key, tile.texture, p.juliaX, p.juliaY);
+            tileDiskLookups.erase(tile.key);
+            continue;
+        }
+
+        // Üst seviyedeki tile'ın ilgili çeyreğini büyüterek göster
+        unresolved++;
+        for (int up = 1; up <= TILE_FALLBACK_LEVELS && up <= tile.key.level; up++)
+        {
+            TileKey parent = {tile.key.level - up, tile.key.x >> up, tile.key.y >> up, juliaXBits, juliaYBits};
+            GLuint texture = tileCache.find(parent);
+            if (!texture)
+                continue;
+            float span = std::ldexp(1.0f, -up);
+            float u = (float)(tile.key.x - parent.x * ((int64_t)1 << up)) * span;
+            float v = (float)(tile.key.y - parent.y * ((int64_t)1 << up)) * span;
+            tile.texture = texture;
+            tile.fieldRect[0] = u;
+            tile.fieldRect[1] = v;
+            tile.fieldRect[2] = u + span;
+            tile.fieldRect[3] = v + span;
+            break;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, p.viewportWidth, p.viewportHeight);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glUseProgram(tileComposeProgram);
+    glUniform1f(composeTimeLocation, p.time);
+    glUniform2f(composeResolutionLocation, p.viewportWidth, p.viewportHeight);
+    glUniform1i(composeModeLocation, p.colorMode);
+    glUniform1i(composeFieldLocation, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(quadVAO);
+    for (const VisibleTile &tile : tiles)
+    {
+        if (!tile.texture)
+            continue;
+        glBindTexture(GL_TEXTURE_2D, tile.texture);
+        glUniform4fv(composeScreenRectLocation, 1, tile.screenRect);
+        glUniform4fv(composeFieldRectLocation, 1, tile.fieldRect);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+
+    return unresolved > 0;
+}
+
+// Kare başına GPU zamanlayıcı sorgusu ve shader sayaç tamponu. Sonuçlar
+// TELEMETRY_SLOTS kare gecikmeyle, yalnızca hazır olduklarında okunur;
+// sonuç gelmemiş bir slot yeniden gerekiyorsa o kare ölçülmeden geçilir.
+class GpuTelemetry
+{
+public:
+    void init()
+    {
+        glGenQueries(TELEMETRY_SLOTS, queries);
+        if (gpuCountersEnabled)
+        {
+            const GLuint zeros[3] = {0, 0, 0};
+            glGenBuffers(TELEMETRY_SLOTS, counterBuffers);
+            for (GLuint buffer : counterBuffers)
+            {
+                glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+                glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(zeros), zeros, GL_DYNAMIC_READ);
+            }
+        }
+    }
+
+    void destroy()
+    {
+        glDeleteQueries(TELEMETRY_SLOTS, queries);
+        if (gpuCountersEnabled)
+            glDeleteBuffers(TELEMETRY_SLOTS, counterBuffers);
+    }
+
+    void beginFrame()
+    {
+        active = !pending[next];
+        if (!active)
+            return;
+        glBeginQuery(GL_TIME_ELAPSED, queries[next]);
+        if (gpuCountersEnabled)
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, counterBuffers[next]);
+    }
+
+    void endFrame()
+    {
+        if (!active)
+            return;
+        glEndQuery(GL_TIME_ELAPSED);
+        // Shader atomiklerinin yazdığı sayaçlar glGetBufferSubData ile okunacak;
+        // bu kuralsız (incoherent) yazmalar bariyer olmadan görünür olmayabilir
+        if (gpuCountersEnabled)
+            glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        pending[next] = true;
+        next = (next + 1) % TELEMETRY_SLOTS;
+    }
+
+    // En eski bekleyen karenin sonuçlarını, hazırsa, örneğe yaz
+    bool collect(FrameSample &sample)
+    {
+        if (!pending[oldest])
+            return false;
+        GLuint available = 0;
+        glGetQueryObjectuiv(queries[oldest], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return false;
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(queries[oldest], GL_QUERY_RESULT, &elapsed);
+        sample.gpuTimeNs = (int64_t)elapsed;
+        if (gpuCountersEnabled)
+        {
+            GLuint counters[3];
+            const GLuint zeros[3] = {0, 0, 0};
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, counterBuffers[oldest]);
+            glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(counters), counters);
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(zeros), zeros);
+            sample.iterations = counters[0];
+            sample.escaped = counters[1];
+            sample.interior = counters[2];
+        }
+        pending[oldest] = false;
+        oldest = (oldest + 1) % TELEMETRY_SLOTS;
+        return true;
+    }
+
+private:
+    GLuint queries[TELEMETRY_SLOTS];
+    GLuint counterBuffers[TELEMETRY_SLOTS];
+    bool pending[TELEMETRY_SLOTS] = {};
+    int next = 0;
+    int oldest = 0;
+    bool active = false;
+};
+
+GpuTelemetry gpuTelemetry;
+
+// Shader derlemesinden önce (render thread'inde) çağrılır
+void initTelemetry()
+{
+    gpuCountersEnabled = GLEW_VERSION_4_3;
+    FractalShaderOptions options;
+    options.telemetryCounters = gpuCountersEnabled;
+    options.telemetryStride = TELEMETRY_STRIDE;
+    options.onProgramCompiled = recordShaderCompile;
+    setFractalShaderOptions(options);
+}
+
+// Metrik sunucusu (telemetri thread'i)
+#ifdef _WIN32
+typedef SOCKET SocketHandle;
+const SocketHandle INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+const int SEND_FLAGS = 0;
+void closeSocket(SocketHandle s) { closesocket(s); }
+int pollSockets(pollfd *fds, int count, int timeoutMs) { return WSAPoll(fds, count, timeoutMs); }
+// Eski soket dosyasını sil; yol soket değilse (AF_UNIX soketi bir reparse
+// noktasıdır) dokunmadan false döner
+bool removeStaleSocket(const std::string &path)
+{
+    DWORD attributes = GetFileAttributesA(path.c_str());
+    if (attributes == INVALID_FILE_ATTRIBUTES)
+        return GetLastError() == ERROR_FILE_NOT_FOUND;
+    if (!(attributes & FILE_ATTRIBUTE_REPARSE_POINT))
+        return false;
+    return DeleteFileA(path.c_str()) != 0;
+}
+#else
+typedef int SocketHandle;
+const SocketHandle INVALID_SOCKET_HANDLE = -1;
+const int SEND_FLAGS = MSG_NOSIGNAL;
+void closeSocket(SocketHandle s) { close(s); }
+int pollSockets(pollfd *fds, int count, int timeoutMs) { return poll(fds, count, timeoutMs); }
+// Eski soket dosyasını sil; yol soket değilse dokunmadan false döner
+bool removeStaleSocket(const std::string &path)
+{
+    struct stat info;
+    if (lstat(path.c_str(), &info) != 0)
+        return errno == ENOENT;
+    if (!S_ISSOCK(info.st_mode))
+        return false;
+    return unlink(path.c_str()) == 0;
+}
+#endif
+
+#ifdef _WIN32
+std::string metricsSocketPath = "julia_fractal.sock";
+#else
+std::string metricsSocketPath = "/tmp/julia_fractal.sock";
+#endif
+std::thread telemetryThread;
+std::atomic<bool> telemetryStop{false};
+
+// Halkadan toplanan değerler; yalnızca telemetri thread'i erişir
+struct TelemetryTotals
+{
+    static const int BUCKETS = 6;
+    const double intervalBuckets[BUCKETS] = {0.0084, 0.0167, 0.025, 0.0334, 0.05, 0.1};
+
+    uint64_t frames = 0;
+    uint64_t gpuFrames = 0;
+    double cpuSeconds = 0.0;
+    double gpuSeconds = 0.0;
+    uint64_t iterations = 0;
+    uint64_t escaped = 0;
+    uint64_t interior = 0;
+    double lastCpuSeconds = 0.0;
+    double lastGpuSeconds = 0.0;
+    double lastIntervalSeconds = 0.0;
+    double jitterSeconds = 0.0; // Ardışık kare aralığı farkının üstel ortalaması
+    uint64_t intervalCounts[BUCKETS + 1] = {};
+    uint64_t intervalSamples = 0;
+    double intervalSum = 0.0;
+
+    void add(const FrameSample &sample)
+    {
+        frames++;
+        lastCpuSeconds = sample.cpuFrameNs / 1e9;
+        cpuSeconds += lastCpuSeconds;
+        if (sample.gpuTimeNs >= 0)
+        {
+            gpuFrames++;
+            lastGpuSeconds = sample.gpuTimeNs / 1e9;
+            gpuSeconds += lastGpuSeconds;
+            // Sayaçlar örneklenmiş; toplamı tüm piksellere ölçekle
+            const uint64_t scale = TELEMETRY_STRIDE * TELEMETRY_STRIDE;
+            iterations += sample.iterations * scale;
+            escaped += sample.escaped * scale;
+            interior += sample.interior * scale;
+        }
+        if (sample.intervalNs > 0)
+        {
+            double interval = sample.intervalNs / 1e9;
+            if (intervalSamples > 0)
+                jitterSeconds += (std::fabs(interval - lastIntervalSeconds) - jitterSeconds) * 0.1;
+            lastIntervalSeconds = interval;
+            intervalSamples++;
+            intervalSum += interval;
+            int bucket = 0;
+            while (bucket < BUCKETS && interval > intervalBuckets[bucket])
+                bucket++;
+            intervalCounts[bucket]++;
+        }
+    }
+};
+
+void writeMetric(std::string &out, const char *name, const char *type, const char *help, double value)
+{
+    out += std::string("# HELP ") + name + " " + help + "\n";
+    out += std::string("# TYPE ") + name + " " + type + "\n";
+    out += std::string(name) + " " + std::to_string(value) + "\n";
+}
+
+std::string formatMetrics(const TelemetryTotals &t)
+{
+    std::string out;
+    writeMetric(out, "julia_frames_total", "counter", "Frames presented.", (double)t.frames);
+    writeMetric(out, "julia_cpu_frame_seconds_total", "counter", "CPU time spent drawing and swapping.", t.cpuSeconds);
+    writeMetric(out, "julia_cpu_frame_seconds", "gauge", "CPU time of the last frame.", t.lastCpuSeconds);
+    writeMetric(out, "julia_gpu_frames_total", "counter", "Frames with a GPU timer result.", (double)t.gpuFrames);
+    writeMetric(out, "julia_gpu_frame_seconds_total", "counter", "GPU time of timed frames.", t.gpuSeconds);
+    writeMetric(out, "julia_gpu_frame_seconds", "gauge", "GPU time of the last timed frame.", t.lastGpuSeconds);
+    writeMetric(out, "julia_gpu_counters_enabled", "gauge", "1 when shader iteration counters are active (GL 4.3).",
+                gpuCountersEnabled ? 1.0 : 0.0);
+    writeMetric(out, "julia_fractal_iterations_total", "counter", "Fractal loop iterations (sampled, scaled).", (double)t.iterations);
+    writeMetric(out, "julia_pixels_escaped_total", "counter", "Pixels that escaped (sampled, scaled).", (double)t.escaped);
+    writeMetric(out, "julia_pixels_interior_total", "counter", "Pixels that did not escape (sampled, scaled).", (double)t.interior);
+    writeMetric(out, "julia_frame_interval_seconds_last", "gauge", "Time between the last two presents.", t.lastIntervalSeconds);
+    writeMetric(out, "julia_frame_jitter_seconds", "gauge", "Moving average of frame interval change.", t.jitterSeconds);
+
+    out += "# HELP julia_frame_interval_seconds Time between presents.\n";
+    out += "# TYPE julia_frame_interval_seconds histogram\n";
+    uint64_t cumulative = 0;
+    for (int i = 0; i < TelemetryTotals::BUCKETS; i++)
+    {
+        cumulative += t.intervalCounts[i];
+        out += "julia_frame_interval_seconds_bucket{le=\"" + std::to_string(t.intervalBuckets[i]) + "\"} " +
+               std::to_string(cumulative) + "\n";
+    }
+    cumulative += t.intervalCounts[TelemetryTotals::BUCKETS];
+    out += "julia_frame_interval_seconds_bucket{le=\"+Inf\"} " + std::to_string(cumulative) + "\n";
+    out += "julia_frame_interval_seconds_sum " + std::to_string(t.intervalSum) + "\n";
+    out += "julia_frame_interval_seconds_count " + std::to_string(t.intervalSamples) + "\n";
+
+    uint64_t samples = latencySamples.load(std::memory_order_relaxed);
+    writeMetric(out, "julia_input_latency_seconds", "gauge", "Input-to-photon latency of the last input event.",
+                latencyLastNs.load(std::memory_order_relaxed) / 1e9);
+    writeMetric(out, "julia_input_latency_seconds_max", "gauge", "Worst input-to-photon latency.",
+                latencyMaxNs.load(std::memory_order_relaxed) / 1e9);
+    writeMetric(out, "julia_input_latency_seconds_sum", "counter", "Sum of input-to-photon latencies.",
+                latencyTotalNs.load(std::memory_order_relaxed) / 1e9);
+    writeMetric(out, "julia_input_latency_seconds_count", "counter", "Input events presented.", (double)samples);
+    writeMetric(out, "julia_telemetry_dropped_total", "counter", "Frame samples dropped because the ring was full.",
+                (double)telemetryDropped.load(std::memory_order_relaxed));
+
+    out += "# HELP julia_shader_compile_seconds Compile and link time per shader program.\n";
+    out += "# TYPE julia_shader_compile_seconds gauge\n";
+    int programs = shaderCompileCount.load(std::memory_order_acquire);
+    for (int i = 0; i < programs; i++)
+    {
+        out += std::string("julia_shader_compile_seconds{program=\"") + shaderCompileStats[i].name + "\"} " +
+               std::to_string(shaderCompileStats[i].durationNs.load(std::memory_order_relaxed) / 1e9) + "\n";
+    }
+    return out;
+}
+
+SocketHandle openMetricsSocket()
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (metricsSocketPath.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Metrics socket path too long: " << metricsSocketPath << std::endl;
+        return INVALID_SOCKET_HANDLE;
+    }
+    std::strcpy(address.sun_path, metricsSocketPath.c_str());
+
+    SocketHandle probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe == INVALID_SOCKET_HANDLE)
+        return INVALID_SOCKET_HANDLE;
+    // Başka bir örnek bu soketi dinliyorsa elinden alma
+    bool inUse = connect(probe, (sockaddr *)&address, sizeof(address)) == 0;
+    closeSocket(probe);
+    if (inUse)
+    {
+        std::cerr << "Metrics socket already in use: " << metricsSocketPath << std::endl;
+        return INVALID_SOCKET_HANDLE;
+    }
+    if (!removeStaleSocket(metricsSocketPath))
+    {
+        std::cerr << "Metrics socket path exists and is not a socket: " << metricsSocketPath << std::endl;
+        return INVALID_SOCKET_HANDLE;
+    }
+
+    SocketHandle listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (bind(listener, (sockaddr *)&address, sizeof(address)) != 0 || listen(listener, 4) != 0)
+    {
+        std::cerr << "Metrics socket bind failed: " << metricsSocketPath << std::endl;
+        closeSocket(listener);
+        return INVALID_SOCKET_HANDLE;
+    }
+    return listener;
+}
+
+// Tek bir istemciye yanıt ver. HTTP isteği gelirse (Prometheus) HTTP başlığı
+// eklenir; kısa sürede hiçbir şey gelmezse (ör. socat) yalnızca metin yazılır.
+void serveMetrics(SocketHandle client, const TelemetryTotals &totals)
+{
+    char request[1024];
+    pollfd clientPoll = {client, POLLIN, 0};
+    bool isHttp = false;
+    if (pollSockets(&clientPoll, 1, 100) > 0)
+    {
+        int received = recv(client, request, sizeof(request) - 1, 0);
+        isHttp = received >= 4 && std::strncmp(request, "GET ", 4) == 0;
+    }
+
+    std::string body = formatMetrics(totals);
+    std::string response;
+    if (isHttp)
+        response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                   std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n";
+    response += body;
+
+    size_t sent = 0;
+    while (sent < response.size())
+    {
+        int n = send(client, response.data() + sent, (int)(response.size() - sent), SEND_FLAGS);
+        if (n <= 0)
+            break;
+        sent += n;
+    }
+    closeSocket(client);
+}
+
+void telemetryLoop()
+{
+    TelemetryTotals totals;
+    SocketHandle listener = openMetricsSocket();
+    if (listener != INVALID_SOCKET_HANDLE)
+        std::cout << "Metrics endpoint: unix:" << metricsSocketPath << std::endl;
+
+    FrameSample sample;
+    while (!telemetryStop.load(std::memory_order_acquire))
+    {
+        while (telemetryRing.pop(sample))
+            totals.add(sample);
+
+        if (listener == INVALID_SOCKET_HANDLE)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+        pollfd listenPoll = {listener, POLLIN, 0};
+        if (pollSockets(&listenPoll, 1, 100) > 0)
+        {
+            SocketHandle client = accept(listener, NULL, NULL);
+            if (client != INVALID_SOCKET_HANDLE)
+            {
+                while (telemetryRing.pop(sample))
+                    totals.add(sample);
+                serveMetrics(client, totals);
+            }
+        }
+    }
+
+    if (listener != INVALID_SOCKET_HANDLE)
+    {
+        closeSocket(listener);
+        removeStaleSocket(metricsSocketPath);
+    }
+}
+
+void startTelemetry()
+{
+#ifdef _WIN32
+    WSADATA wsaData;
+    WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+    telemetryThread = std::thread(telemetryLoop);
+}
+
+void stopTelemetry()
+{
+    telemetryStop.store(true, std::memory_order_release);
+    if (telemetryThread.joinable())
+        telemetryThread.join();
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+// Video girişi
+//
+// Video, Y4M (YUV4MPEG2, 4:2:0) olarak okunur: .y4m dosyası doğrudan, diğer
+// biçimler ffmpeg alt süreciyle Y4M'ye çevrilerek. Çözücü thread'i kareleri
+// kalıcı eşlenmiş (persistent-mapped) bir PBO halkasının slotlarına doğrudan
+// okur; render thread'i en yeni hazır kareyi PBO'dan dokulara aktarır ve
+// slotu GPU okuması bitene kadar fence ile tutar. Böylece çözme, aktarım ve
+// çizim birbirini beklemeden örtüşür.
+const int VIDEO_SLOTS = 3;
+
+enum VideoSlotState
+{
+    SLOT_FREE,    // Çözücü doldurabilir
+    SLOT_FILLING, // Çözücü yazıyor
+    SLOT_READY,   // Gösterilmeye hazır
+    SLOT_IN_USE   // GPU aktarımı sürüyor (fence bekleniyor)
+};
+
+class VideoInput
+{
+public:
+    // Kaynağı aç ve başlığı oku (ana thread'de, render thread'inden önce)
+    bool open(const std::string &videoPath)
+    {
+        path = videoPath;
+        if (!openSource())
+            return false;
+        chromaWidth = (width + 1) / 2;
+        chromaHeight = (height + 1) / 2;
+        frameBytes = (size_t)width * height + 2 * (size_t)chromaWidth * chromaHeight;
+        std::cout << "Video input: " << path << " (" << width << "x" << height << ", "
+                  << 1e9 / frameDurationNs << " fps)" << std::endl;
+        return true;
+    }
+
+    bool isOpen() const { return width > 0; }
+
+    // GL kaynaklarını oluştur ve çözücüyü başlat (render thread'inde)
+    void initGL()
+    {
+        if (!isOpen())
+            return;
+
+        GLsizei planeWidths[3] = {width, chromaWidth, chromaWidth};
+        GLsizei planeHeights[3] = {height, chromaHeight, chromaHeight};
+        glGenTextures(3, textures);
+        for (int i = 0; i < 3; i++)
+        {
+            glBindTexture(GL_TEXTURE_2D, textures[i]);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, planeWidths[i], planeHeights[i], 0, GL_RED, GL_UNSIGNED_BYTE, NULL);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+
+        persistent = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+        if (persistent)
+        {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glGenBuffers(1, &pbo);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+            glBufferStorage(GL_PIXEL_UNPACK_BUFFER, frameBytes * VIDEO_SLOTS, NULL, flags);
+            mapped = (uint8_t *)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, frameBytes * VIDEO_SLOTS, flags);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            persistent = mapped != NULL;
+        }
+        if (!persistent)
+        {
+            // Eski sürücüler: istemci belleğinden aktarım (yine de çözme ayrı thread'de)
+            for (std::vector<uint8_t> &buffer : staging)
+                buffer.resize(frameBytes);
+        }
+
+        for (int i = 0; i < VIDEO_SLOTS; i++)
+        {
+            fences[i] = NULL;
+            slotState[i].store(SLOT_FREE, std::memory_order_relaxed);
+        }
+        stop.store(false, std::memory_order_relaxed);
+        decoder = std::thread(&VideoInput::decodeLoop, this);
+    }
+
+    // En yeni hazır kareyi dokulara aktar; eskileri atla. Hiçbir zaman beklemez.
+    void update()
+    {
+        if (!isOpen())
+            return;
+
+        // GPU'nun okumayı bitirdiği slotları çözücüye geri ver
+        for (int i = 0; i < VIDEO_SLOTS; i++)
+        {
+            if (slotState[i].load(std::memory_order_relaxed) != SLOT_IN_USE)
+                continue;
+            GLenum status = glClientWaitSync(fences[i], 0, 0);
+            if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+            {
+                glDeleteSync(fences[i]);
+                fences[i] = NULL;
+                slotState[i].store(SLOT_FREE, std::memory_order_release);
+            }
+        }
+
+        int newest = -1;
+        for (int i = 0; i < VIDEO_SLOTS; i++)
+        {
+            if (slotState[i].load(std::memory_order_acquire) != SLOT_READY)
+                continue;
+            if (newest < 0 || slotFrame[i] > slotFrame[newest])
+            {
+                if (newest >= 0)
+                    slotState[newest].store(SLOT_FREE, std::memory_order_release);
+                newest = i;
+            }
+            else
+            {
+                slotState[i].store(SLOT_FREE, std::memory_order_release);
+            }
+        }
+        if (newest < 0)
+            return;
+
+        // Y, U ve V düzlemleri slot içinde art arda duruyor
+        const uint8_t *base = persistent ? (const uint8_t *)(size_t)(newest * frameBytes) : staging[newest].data();
+        const uint8_t *planes[3] = {base, base + (size_t)width * height,
+                                    base + (size_t)width * height + (size_t)chromaWidth * chromaHeight};
+        GLsizei planeWidths[3] = {width, chromaWidth, chromaWidth};
+        GLsizei planeHeights[3] = {height, chromaHeight, chromaHeight};
+
+        if (persistent)
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (int i = 0; i < 3; i++)
+        {
+            glBindTexture(GL_TEXTURE_2D, textures[i]);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, planeWidths[i], planeHeights[i], GL_RED, GL_UNSIGNED_BYTE, planes[i]);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        if (persistent)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            fences[newest] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            slotState[newest].store(SLOT_IN_USE, std::memory_order_relaxed);
+        }
+        else
+        {
+            // glTexSubImage2D istemci belleğini çağrı içinde kopyalar
+            slotState[newest].store(SLOT_FREE, std::memory_order_release);
+        }
+    }
+
+    // Y, U, V düzlemlerinin dokuları (video yoksa 0)
+    GLuint planeTexture(int plane) const { return textures[plane]; }
+
+    // Çözücüyü durdur ve GL kaynaklarını bırak (render thread'inde)
+    void shutdown()
+    {
+        if (!isOpen())
+            return;
+        stop.store(true, std::memory_order_release);
+        if (decoder.joinable())
+            decoder.join();
+        closeSource();
+
+        for (GLsync &fence : fences)
+        {
+            if (fence)
+                glDeleteSync(fence);
+            fence = NULL;
+        }
+        if (pbo)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteBuffers(1, &pbo);
+            pbo = 0;
+        }
+        glDeleteTextures(3, textures);
+    }
+
+private:
+    bool openSource()
+    {
+        bool isY4m = path.size() > 4 && path.compare(path.size() - 4, 4, ".y4m") == 0;
+        if (isY4m)
+        {
+            source = fopen(path.c_str(), "rb");
+            fromPipe = false;
+        }
+        else
+        {
+            source = spawnDecoder();
+            fromPipe = true;
+        }
+        if (!source)
+        {
+            std::cerr << "Video open failed: " << path << std::endl;
+            return false;
+        }
+        if (!readHeader())
+        {
+            std::cerr << "Video is not 8-bit 4:2:0 YUV4MPEG2: " << path << std::endl;
+            closeSource();
+            return false;
+        }
+        return true;
+    }
 
-// Vertex shader kodu
-const char *vertexShaderSource = R"(
-    #version 330 core
-    layout (location = 0) in vec3 aPos;
-    layout (location = 1) in vec2 aTexCoord;
-    out vec2 TexCoord;
-    void main() {
-        gl_Position = vec4(aPos, 1.0);
-        TexCoord = aTexCoord;
+    // ffmpeg'i kabuk olmadan başlat: dosya adı tek bir argüman olarak geçer,
+    // içindeki tırnak, $ ya da ` yorumlanmaz. Çıktısı borudan okunur.
+#ifdef _WIN32
+    FILE *spawnDecoder()
+    {
+        SECURITY_ATTRIBUTES security = {sizeof(security), NULL, TRUE};
+        HANDLE readPipe, writePipe;
+        if (!CreatePipe(&readPipe, &writePipe, &security, 0))
+            return NULL;
+        SetHandleInformation(readPipe, HANDLE_FLAG_INHERIT, 0);
+
+        STARTUPINFOA startup = {};
+        startup.cb = sizeof(startup);
+        startup.dwFlags = STARTF_USESTDHANDLES;
+        startup.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+        startup.hStdOutput = writePipe;
+        startup.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+        PROCESS_INFORMATION process = {};
+        std::string command = "ffmpeg -loglevel error -i " + quoteArgument(path) +
+                              " -f yuv4mpegpipe -pix_fmt yuv420p -";
+        bool started = CreateProcessA(NULL, &command[0], NULL, NULL, TRUE, 0, NULL, NULL, &startup, &process);
+        CloseHandle(writePipe);
+        if (!started)
+        {
+            CloseHandle(readPipe);
+            return NULL;
+        }
+        CloseHandle(process.hThread);
+        decoderProcess = process.hProcess;
+        return _fdopen(_open_osfhandle((intptr_t)readPipe, _O_RDONLY | _O_BINARY), "rb");
     }
-)";
 
-// Fragment shader kodu - Sanatsal ve Psychedelic geliştirmeler
-const char *fragmentShaderSource = R"(
-    #version 330 core
-    out vec4 FragColor;
-    in vec2 TexCoord;
-    
-    uniform vec2 resolution;
-    uniform float time;
-    uniform float zoom;
-    uniform vec2 offset;
-    uniform vec2 juliaParam;
-    uniform int mode;
-    uniform float complexity;
-    
-    #define MAX_ITER 200 // Daha hızlı iterasyonlar için düşürüldü, daha akışkan hareket
-    #define PI 3.14159265359
-    #define TAU 6.28318530718
-    
-    // Psychedelic renk paletleri
-    vec3 psychedelicPalette1(float t) {
-        // Hızlı, canlı, dönen tonlar
-        vec3 color = 0.5 + 0.5 * cos(TAU * (t * 3.0 + vec3(0.0, 0.333, 0.666) + time * 0.5));
-        return clamp(color, 0.0, 1.0); // Renk değerlerini 0-1 aralığında tutmak için
-    }
-
-    vec3 psychedelicPalette2(float t) {
-        // Kontrastlı, şok edici renk geçişleri
-        vec3 c1 = vec3(1.0, 0.0, 0.5); // Magenta
-        vec3 c2 = vec3(0.0, 1.0, 0.8); // Turkuaz
-        vec3 c3 = vec3(1.0, 0.8, 0.0); // Turuncu
-        vec4 c4 = vec4(0.5, 0.0, 1.0, 1.0); // Mor (alpha ile uyum için)
-
-        t = fract(t + time * 0.2); // Daha hızlı kayma
-        if (t < 0.25) return mix(c1, c2, smoothstep(0.0, 1.0, t * 4.0));
-        else if (t < 0.5) return mix(c2, c3, smoothstep(0.0, 1.0, (t - 0.25) * 4.0));
-        else if (t < 0.75) return mix(c3, c4.rgb, smoothstep(0.0, 1.0, (t - 0.5) * 4.0));
-        else return mix(c4.rgb, c1, smoothstep(0.0, 1.0, (t - 0.75) * 4.0));
-    }
-
-    vec3 quantumFlux(float t) {
-        // Kuantum fiziği esinlenmesi, daha dinamik ve parlayan
-        float wave = sin(t * 30.0 + time * 5.0) * 0.5 + 0.5; // Daha hızlı titreşim
-        vec3 photon = vec3(1.0, 1.0, 0.8) * (1.0 + sin(time * 7.0) * 0.1); // Parlama
-        vec3 electron = vec3(0.2, 0.4, 1.0) * (1.0 + cos(time * 6.0) * 0.1);
-        vec3 quantum = vec3(0.8, 0.2, 0.8) * (1.0 + sin(time * 8.0) * 0.1);
-        
-        return mix(mix(photon, electron, wave), quantum, sin(t * 10.0 + time * 3.0) * 0.5 + 0.5);
-    }
-
-    vec3 cosmicPalette(float t) {
-        // Derin uzay ve nebula renkleri, daha akışkan
-        vec3 deep = vec3(0.05, 0.0, 0.2); 
-        vec3 nebula = vec3(0.8, 0.2, 0.9); 
-        vec3 star = vec3(1.0, 0.9, 0.3); 
-        vec3 plasma = vec3(0.0, 0.8, 1.0); 
-        
-        t = fract(t + time * 0.05) * 4.0; // Hafif kayma
-        if(t < 1.0) return mix(deep, nebula, smoothstep(0.0, 1.0, t));
-        else if(t < 2.0) return mix(nebula, star, smoothstep(0.0, 1.0, t-1.0));
-        else if(t < 3.0) return mix(star, plasma, smoothstep(0.0, 1.0, t-2.0));
-        return mix(plasma, deep, smoothstep(0.0, 1.0, t-3.0));
+    // CommandLineToArgvW kurallarına göre tek argüman olarak tırnakla
+    static std::string quoteArgument(const std::string &argument)
+    {
+        std::string quoted = "\"";
+        size_t backslashes = 0;
+        for (char ch : argument)
+        {
+            if (ch == '\\')
+            {
+                backslashes++;
+                continue;
+            }
+            quoted.append(ch == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+            backslashes = 0;
+            quoted += ch;
+        }
+        quoted.append(backslashes * 2, '\\');
+        return quoted + "\"";
     }
-    
-    // Ana color function
-    vec3 getColor(float t, int colorMode, float time) {
-        switch(colorMode) {
-            case 0: return psychedelicPalette1(t);
-            case 1: return psychedelicPalette2(t);
-            case 2: return quantumFlux(t);
-            case 3: return cosmicPalette(t);
-            default: return psychedelicPalette1(t);
+#else
+    FILE *spawnDecoder()
+    {
+        int fds[2];
+        if (pipe(fds) != 0)
+            return NULL;
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+        posix_spawn_file_actions_addclose(&actions, fds[0]);
+        posix_spawn_file_actions_addclose(&actions, fds[1]);
+
+        std::string input = path;
+        char *arguments[] = {(char *)"ffmpeg", (char *)"-loglevel", (char *)"error", (char *)"-i", &input[0],
+                             (char *)"-f", (char *)"yuv4mpegpipe", (char *)"-pix_fmt", (char *)"yuv420p",
+                             (char *)"-", NULL};
+        int result = posix_spawnp(&decoderPid, "ffmpeg", &actions, NULL, arguments, environ);
+        posix_spawn_file_actions_destroy(&actions);
+        close(fds[1]);
+        if (result != 0)
+        {
+            close(fds[0]);
+            decoderPid = 0;
+            return NULL;
         }
+        return fdopen(fds[0], "rb");
     }
-    
-    // Gelişmiş geometrik transformasyonlar
-    vec2 kaleidoscope(vec2 uv, float segments) {
-        float angle = atan(uv.y, uv.x);
-        float radius = length(uv);
-        angle = mod(angle, TAU / segments);
-        angle = abs(angle - PI / segments);
-        return vec2(cos(angle), sin(angle)) * radius;
+#endif
+
+    void closeSource()
+    {
+        if (!source)
+            return;
+        fclose(source);
+        source = NULL;
+        if (!fromPipe)
+            return;
+        // Kapanışta çözücü hâlâ yazıyor olabilir; sonlandırıp bekle
+#ifdef _WIN32
+        if (decoderProcess)
+        {
+            TerminateProcess(decoderProcess, 0);
+            WaitForSingleObject(decoderProcess, INFINITE);
+            CloseHandle(decoderProcess);
+            decoderProcess = NULL;
+        }
+#else
+        if (decoderPid > 0)
+        {
+            kill(decoderPid, SIGTERM);
+            waitpid(decoderPid, NULL, 0);
+            decoderPid = 0;
+        }
+#endif
     }
-    
-    vec2 fractalDistortion(vec2 uv, float time, float intensity) {
-        // Çoklu fraktal katmanları ve girdap etkisi
-        float scale1 = 3.0, scale2 = 7.0, scale3 = 13.0;
-        
-        vec2 distort = vec2(
-            sin(uv.y * scale1 + time * 1.5) * sin(uv.x * scale2 + time * 1.3) * intensity,
-            cos(uv.x * scale1 + time * 1.7) * cos(uv.y * scale3 + time * 1.9) * intensity
-        );
-        
-        // Girdap deformasyonu
-        float angle = atan(uv.y, uv.x);
-        float dist = length(uv);
-        float swirl = sin(dist * 10.0 - time * 2.0) * 0.05 * intensity;
-        angle += swirl;
-        distort += vec2(cos(angle), sin(angle)) * dist * 0.1 * intensity;
-
-        return uv + distort;
+
+    bool readLine(std::string &line)
+    {
+        line.clear();
+        int ch;
+        while ((ch = fgetc(source)) != EOF && ch != '\n')
+            line += (char)ch;
+        return ch == '\n';
     }
-    
-    void main() {
-        vec2 uv = (gl_FragCoord.xy - 0.5 * resolution.xy) / min(resolution.x, resolution.y);
-        vec2 originalUV = uv;
-        
-        // Dinamik zoom ve solunum efekti - daha belirgin
-        float breathe = sin(time * 0.7) * 0.2 + 1.0;
-        float dynamicZoom = zoom * (1.0 + sin(time * 0.1) * 0.5);
-        uv = uv * (3.0 / dynamicZoom) * breathe;
-        
-        // Karmaşıklık seviyesine göre transformasyonlar - daha etkileşimli
-        uv = kaleidoscope(uv, 4.0 + sin(time * 0.4) * 3.0 + complexity * 5.0);
-        
-        // Fraktal distorsiyon - karmaşıklıkla daha yoğun
-        uv = fractalDistortion(uv, time, complexity * 0.5 + sin(time * 0.8) * 0.1);
-        uv += offset;
-        
-        // Julia parametrelerinde harmonic motion - daha hızlı ve geniş
-        vec2 c = juliaParam;
-        c.x += sin(time * 0.25) * 0.2 * complexity;
-        c.y += cos(time * 0.35) * 0.2 * complexity;
-        
-        // Ana fraktal hesaplama
-        vec2 z = uv;
-        int iter;
-        float smoothIter = 0.0;
-        
-        for(iter = 0; iter < MAX_ITER; iter++) {
-            float x = z.x * z.x - z.y * z.y + c.x;
-            float y = 2.0 * z.x * z.y + c.y;
-            
-            float magnitudeSq = x*x + y*y;
-            if(magnitudeSq > 4.0) {
-                smoothIter = float(iter) + 1.0 - log2(log2(magnitudeSq));
-                break;
+
+    // "YUV4MPEG2 W1920 H1080 F30:1 Ip A1:1 C420jpeg"
+    bool readHeader()
+    {
+        std::string line;
+        if (!readLine(line) || line.rfind("YUV4MPEG2", 0) != 0)
+            return false;
+
+        int headerWidth = 0, headerHeight = 0;
+        int64_t rateNum = 30, rateDen = 1;
+        size_t pos = 0;
+        while (pos < line.size())
+        {
+            size_t end = line.find(' ', pos);
+            if (end == std::string::npos)
+                end = line.size();
+            std::string token = line.substr(pos, end - pos);
+            pos = end + 1;
+            if (token.empty())
+                continue;
+            if (token[0] == 'W')
+                headerWidth = atoi(token.c_str() + 1);
+            else if (token[0] == 'H')
+                headerHeight = atoi(token.c_str() + 1);
+            else if (token[0] == 'F')
+                sscanf(token.c_str() + 1, "%lld:%lld", (long long *)&rateNum, (long long *)&rateDen);
+            else if (token[0] == 'C' && token != "C420" && token != "C420jpeg" && token != "C420paldv" &&
+                     token != "C420mpeg2")
+                return false; // 8 bit dışı (C420p10 vb.) ve diğer alt örneklemeler desteklenmez
+        }
+        if (headerWidth <= 0 || headerHeight <= 0 || rateNum <= 0 || rateDen <= 0)
+            return false;
+        // Döngüde yeniden açılan kaynak aynı boyutta olmalı
+        if (width && (headerWidth != width || headerHeight != height))
+            return false;
+        width = headerWidth;
+        height = headerHeight;
+        frameDurationNs = 1000000000LL * rateDen / rateNum;
+        return true;
+    }
+
+    bool readFrame(uint8_t *destination)
+    {
+        std::string line;
+        if (!readLine(line) || line.rfind("FRAME", 0) != 0)
+            return false;
+        return fread(destination, 1, frameBytes, source) == frameBytes;
+    }
+
+    // Çözücü thread'i: boş slot bul, kareyi doğrudan slota oku, sunum
+    // zamanına kadar bekleyip hazır olarak işaretle. Dosya bitince başa sarar.
+    void decodeLoop()
+    {
+        uint64_t frameIndex = 0;
+        int64_t startNs = nowNs();
+        while (!stop.load(std::memory_order_acquire))
+        {
+            int slot = -1;
+            for (int i = 0; i < VIDEO_SLOTS && slot < 0; i++)
+            {
+                if (slotState[i].load(std::memory_order_acquire) == SLOT_FREE)
+                    slot = i;
             }
-            z = vec2(x, y);
-        }
-        
-        if(iter == MAX_ITER) {
-            // İç bölge için hareketli bir desen
-            float innerPattern = sin(length(originalUV) * 30.0 + time * 10.0) * 0.5 + 0.5;
-            vec3 innerColor = getColor(innerPattern, mode, time) * 0.2;
-            FragColor = vec4(innerColor, 1.0);
-        } else {
-            // Gelişmiş renk hesaplaması
-            float normalizedIter = smoothIter / float(MAX_ITER);
-            vec3 color = getColor(normalizedIter, mode, time);
-            
-            // Artistik efektler - daha fazla parıltı ve titreşim
-            float glow = exp(-smoothIter * 0.01) * (0.5 + sin(time * 5.0) * 0.5);
-            color += getColor(time * 0.2, (mode + 1) % 4, time) * glow * 2.0;
-            
-            // Vignette efekti - daha dramatik
-            float vignette = 1.0 - length(originalUV) * 0.8;
-            vignette = smoothstep(0.0, 1.0, vignette);
-            vignette = pow(vignette, 2.0);
-            
-            // Dynamic brightness - daha belirgin nabız atışı
-            float pulse = sin(time * 4.0) * 0.3 + 0.7;
-            color *= vignette * pulse;
-            
-            // HDR ve Tonemap - daha parlak ve dinamik
-            color = color / (0.1 + color);
-            color = pow(color, vec3(1.0 / 2.0));
-
-            // Film grain effect - hafif kumlanma
-            float grain = fract(sin(dot(originalUV * resolution, vec2(12.9898, 78.233))) * 43758.5453);
-            color += (grain - 0.5) * 0.03;
-            
-            FragColor = vec4(color, 1.0);
+            if (slot < 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+
+            slotState[slot].store(SLOT_FILLING, std::memory_order_relaxed);
+            uint8_t *destination = persistent ? mapped + slot * frameBytes : staging[slot].data();
+            if (!source || !readFrame(destination))
+            {
+                slotState[slot].store(SLOT_FREE, std::memory_order_release);
+                closeSource();
+                if (!openSource())
+                    return;
+                continue;
+            }
+
+            std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+                std::chrono::nanoseconds(startNs + (int64_t)frameIndex * frameDurationNs)));
+            slotFrame[slot] = frameIndex++;
+            slotState[slot].store(SLOT_READY, std::memory_order_release);
         }
     }
-)";
 
-// Shader derleme ve bağlama
-GLuint createShader(const char *source, GLenum type)
+    std::string path;
+    FILE *source = NULL;
+    bool fromPipe = false;
+#ifdef _WIN32
+    HANDLE decoderProcess = NULL;
+#else
+    pid_t decoderPid = 0;
+#endif
+    int width = 0;
+    int height = 0;
+    int chromaWidth = 0;
+    int chromaHeight = 0;
+    size_t frameBytes = 0;
+    int64_t frameDurationNs = 33333333;
+
+    bool persistent = false;
+    GLuint pbo = 0;
+    uint8_t *mapped = NULL;
+    std::vector<uint8_t> staging[VIDEO_SLOTS];
+    GLuint textures[3] = {};
+    GLsync fences[VIDEO_SLOTS] = {};
+    uint64_t slotFrame[VIDEO_SLOTS] = {}; // Slot durumu (acquire/release) ile korunur
+    std::atomic<int> slotState[VIDEO_SLOTS];
+
+    std::thread decoder;
+    std::atomic<bool> stop{false};
+};
+
+VideoInput videoInput;
+
+// 3D quaternion modu (CPU, başsız düğümler için)
+//
+// --headless-3d=FILE.ppm pencere ve GL olmadan aynı sahneyi tüm çekirdeklerde
+// çizer. GPU yolundaki koni ön geçişi burada blok başına yapılır: her blok
+// önce merkez konisini ilerletir, sonra bloğun pikselleri oradan başlar.
+
+const int CONE_DOWNSAMPLE = FRACTAL_CONE_DOWNSAMPLE; // GPU koni ön geçişiyle aynı
+
+// İş öğelerini (0..count-1) tüm çekirdeklere dağıt
+void parallelFor(int count, const std::function<void(int)> &work)
+{
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<int> nextIndex{0};
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threadCount; i++)
+    {
+        workers.emplace_back([&]() {
+            int index;
+            while ((index = nextIndex.fetch_add(1, std::memory_order_relaxed)) < count)
+                work(index);
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+struct Vec3
+{
+    double x, y, z;
+
+    Vec3 operator+(const Vec3 &o) const { return {x + o.x, y + o.y, z + o.z}; }
+    Vec3 operator-(const Vec3 &o) const { return {x - o.x, y - o.y, z - o.z}; }
+    Vec3 operator*(double s) const { return {x * s, y * s, z * s}; }
+};
+
+double dot(const Vec3 &a, const Vec3 &b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+Vec3 cross(const Vec3 &a, const Vec3 &b) { return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x}; }
+Vec3 normalize(const Vec3 &v) { return v * (1.0 / std::sqrt(dot(v, v))); }
+
+const int QJ_ITER = 11;
+const double QJ_BOUND = 2.0;
+const double QJ_FOCAL = 1.8;
+const int QJ_MARCH_STEPS = 96;
+
+struct QuaternionScene
+{
+    double c[4];
+    Vec3 origin, forward, right, up;
+    double width, height;
+    float time;
+    int colorMode;
+
+    Vec3 ray(double px, double py) const
+    {
+        double u = (px - 0.5 * width) / height;
+        double v = (py - 0.5 * height) / height;
+        return normalize(forward * QJ_FOCAL + right * u + up * v);
+    }
+};
+
+QuaternionScene makeQuaternionScene(const FrameParams &p, int width, int height)
+{
+    QuaternionScene scene;
+    scene.c[0] = p.juliaX;
+    scene.c[1] = p.juliaY;
+    scene.c[2] = 0.2 + 0.1 * std::sin(p.time * 0.3) * p.complexity;
+    scene.c[3] = 0.0;
+    double dist = 7.5 / p.zoom;
+    double yaw = p.time * 0.1 + p.offsetX * 2.0;
+    double pitch = std::max(-1.4, std::min(1.4, p.offsetY * 2.0));
+    scene.origin = Vec3{std::cos(pitch) * std::sin(yaw), std::sin(pitch), std::cos(pitch) * std::cos(yaw)} * dist;
+    scene.forward = normalize(scene.origin * -1.0);
+    scene.right = normalize(cross(scene.forward, Vec3{0.0, 1.0, 0.0}));
+    scene.up = cross(scene.right, scene.forward);
+    scene.width = width;
+    scene.height = height;
+    scene.time = p.time;
+    scene.colorMode = p.colorMode;
+    return scene;
+}
+
+double quaternionDE(const Vec3 &p, const double c[4], double &trap)
+{
+    double z[4] = {p.x, p.y, p.z, 0.0};
+    double md2 = 1.0;
+    double mz2 = p.x * p.x + p.y * p.y + p.z * p.z;
+    trap = 1e10;
+    for (int i = 0; i < QJ_ITER; i++)
+    {
+        md2 *= 4.0 * mz2;
+        double x = z[0] * z[0] - z[1] * z[1] - z[2] * z[2] - z[3] * z[3] + c[0];
+        z[1] = 2.0 * z[0] * z[1] + c[1];
+        z[2] = 2.0 * z[0] * z[2] + c[2];
+        z[3] = 2.0 * z[0] * z[3] + c[3];
+        z[0] = x;
+        trap = std::min(trap, z[0] * z[0] + z[1] * z[1] + z[2] * z[2]);
+        mz2 = z[0] * z[0] + z[1] * z[1] + z[2] * z[2] + z[3] * z[3];
+        if (mz2 > 16.0)
+            break;
+    }
+    return 0.25 * std::sqrt(mz2 / md2) * std::log(mz2);
+}
+
+// Işının sınır küresine giriş/çıkış uzaklıkları; ıskalarsa false
+bool boundRange(const Vec3 &ro, const Vec3 &rd, double &tNear, double &tFar)
+{
+    double b = dot(ro, rd);
+    double h = b * b - dot(ro, ro) + QJ_BOUND * QJ_BOUND;
+    if (h < 0.0)
+        return false;
+    h = std::sqrt(h);
+    tNear = std::max(-b - h, 0.0);
+    tFar = -b + h;
+    return true;
+}
+
+// GLSL yardımcılarının karşılıkları
+double fractPart(double x) { return x - std::floor(x); }
+
+double smoothStep(double edge0, double edge1, double x)
+{
+    double t = std::max(0.0, std::min(1.0, (x - edge0) / (edge1 - edge0)));
+    return t * t * (3.0 - 2.0 * t);
+}
+
+Vec3 mix(const Vec3 &a, const Vec3 &b, double t) { return a * (1.0 - t) + b * t; }
+
+// Ortak shader başlığındaki getColor paletlerinin karşılığı
+Vec3 cpuPalette(double t, int colorMode, float time)
 {
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, NULL);
-    glCompileShader(shader);
+    const double TAU = 6.28318530718;
+    switch (colorMode)
+    {
+    case 1:
+    {
+        // psychedelicPalette2
+        Vec3 c1 = {1.0, 0.0, 0.5}, c2 = {0.0, 1.0, 0.8}, c3 = {1.0, 0.8, 0.0}, c4 = {0.5, 0.0, 1.0};
+        t = fractPart(t + time * 0.2);
+        if (t < 0.25)
+            return mix(c1, c2, smoothStep(0.0, 1.0, t * 4.0));
+        if (t < 0.5)
+            return mix(c2, c3, smoothStep(0.0, 1.0, (t - 0.25) * 4.0));
+        if (t < 0.75)
+            return mix(c3, c4, smoothStep(0.0, 1.0, (t - 0.5) * 4.0));
+        return mix(c4, c1, smoothStep(0.0, 1.0, (t - 0.75) * 4.0));
+    }
+    case 2:
+    {
+        // quantumFlux
+        double wave = std::sin(t * 30.0 + time * 5.0) * 0.5 + 0.5;
+        Vec3 photon = Vec3{1.0, 1.0, 0.8} * (1.0 + std::sin(time * 7.0) * 0.1);
+        Vec3 electron = Vec3{0.2, 0.4, 1.0} * (1.0 + std::cos(time * 6.0) * 0.1);
+        Vec3 quantum = Vec3{0.8, 0.2, 0.8} * (1.0 + std::sin(time * 8.0) * 0.1);
+        return mix(mix(photon, electron, wave), quantum, std::sin(t * 10.0 + time * 3.0) * 0.5 + 0.5);
+    }
+    case 3:
+    {
+        // cosmicPalette
+        Vec3 deep = {0.05, 0.0, 0.2}, nebula = {0.8, 0.2, 0.9}, star = {1.0, 0.9, 0.3}, plasma = {0.0, 0.8, 1.0};
+        t = fractPart(t + time * 0.05) * 4.0;
+        if (t < 1.0)
+            return mix(deep, nebula, smoothStep(0.0, 1.0, t));
+        if (t < 2.0)
+            return mix(nebula, star, smoothStep(0.0, 1.0, t - 1.0));
+        if (t < 3.0)
+            return mix(star, plasma, smoothStep(0.0, 1.0, t - 2.0));
+        return mix(plasma, deep, smoothStep(0.0, 1.0, t - 3.0));
+    }
+    default:
+        // psychedelicPalette1
+        return {0.5 + 0.5 * std::cos(TAU * (t * 3.0 + 0.0 + time * 0.5)),
+                0.5 + 0.5 * std::cos(TAU * (t * 3.0 + 0.333 + time * 0.5)),
+                0.5 + 0.5 * std::cos(TAU * (t * 3.0 + 0.666 + time * 0.5))};
+    }
+}
 
-    GLint success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success)
+// Bloğu kapsayan koniyi ilerlet; blok pikselleri için güvenli başlangıç uzaklığı
+double coneStart(const QuaternionScene &scene, double px, double py, int blockSize)
+{
+    Vec3 rd = scene.ray(px, py);
+    double tNear, tFar;
+    if (!boundRange(scene.origin, rd, tNear, tFar))
+        return 1e10;
+    double coneSlope = blockSize * 0.7072 / (scene.height * QJ_FOCAL);
+    double t = tNear, safeT = tNear, trap;
+    for (int i = 0; i < QJ_MARCH_STEPS && t < tFar; i++)
     {
-        char infoLog[512];
-        glGetShaderInfoLog(shader, 512, NULL, infoLog);
-        std::cerr << "Shader compilation error: " << infoLog << std::endl;
+        double d = quaternionDE(scene.origin + rd * t, scene.c, trap);
+        if (d < t * coneSlope)
+            return safeT;
+        safeT = t;
+        t += d;
     }
-    return shader;
+    return t;
 }
 
-void initShaders()
+Vec3 shadeQuaternionPixel(const QuaternionScene &scene, double px, double py, double tStart)
 {
-    GLuint vertexShader = createShader(vertexShaderSource, GL_VERTEX_SHADER);
-    GLuint fragmentShader = createShader(fragmentShaderSource, GL_FRAGMENT_SHADER);
+    Vec3 rd = scene.ray(px, py);
+    Vec3 color = cpuPalette(0.5 + rd.y * 0.2, scene.colorMode, scene.time) * 0.15;
+    double tNear, tFar;
+    if (!boundRange(scene.origin, rd, tNear, tFar))
+        return color;
 
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
+    double pixelSlope = 1.0 / (scene.height * QJ_FOCAL);
+    double t = std::max(tStart, tNear), trap = 0.0;
+    int steps = 0;
+    bool hit = false;
+    for (; steps < QJ_MARCH_STEPS && t < tFar; steps++)
+    {
+        double d = quaternionDE(scene.origin + rd * t, scene.c, trap);
+        if (d < t * pixelSlope * 0.5)
+        {
+            hit = true;
+            break;
+        }
+        t += d;
+    }
+    if (!hit)
+        return color;
 
-    GLint success;
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success)
+    Vec3 p = scene.origin + rd * t;
+    double eps = t * pixelSlope, unused;
+    Vec3 k0 = {1, -1, -1}, k1 = {-1, -1, 1}, k2 = {-1, 1, -1}, k3 = {1, 1, 1};
+    Vec3 n = normalize(k0 * quaternionDE(p + k0 * eps, scene.c, unused) +
+                       k1 * quaternionDE(p + k1 * eps, scene.c, unused) +
+                       k2 * quaternionDE(p + k2 * eps, scene.c, unused) +
+                       k3 * quaternionDE(p + k3 * eps, scene.c, unused));
+    Vec3 lightDir = normalize(Vec3{0.6, 0.8, 0.4});
+    double diffuse = std::max(dot(n, lightDir), 0.0);
+    Vec3 reflected = rd - n * (2.0 * dot(n, rd));
+    double specular = std::pow(std::max(dot(reflected, lightDir), 0.0), 24.0);
+    double occlusion = 0.0;
+    for (int i = 1; i <= 3; i++)
     {
-        char infoLog[512];
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        std::cerr << "Shader program linking error: " << infoLog << std::endl;
+        double h = 0.04 * i;
+        occlusion += (h - quaternionDE(p + n * h, scene.c, unused)) / i;
     }
+    occlusion = std::max(0.0, std::min(1.0, 1.0 - 4.0 * occlusion));
+    Vec3 base = cpuPalette(std::sqrt(trap) * 0.5, scene.colorMode, scene.time);
+    return (base * (0.2 + 0.8 * diffuse) + Vec3{1, 1, 1} * (specular * 0.4)) * occlusion;
+}
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+// RGB8, üst satır önce (PPM sırası)
+std::vector<uint8_t> renderQuaternionCPU(const FrameParams &p, int width, int height)
+{
+    QuaternionScene scene = makeQuaternionScene(p, width, height);
+    std::vector<uint8_t> image((size_t)width * height * 3);
+    int blocksX = (width + CONE_DOWNSAMPLE - 1) / CONE_DOWNSAMPLE;
+    int blocksY = (height + CONE_DOWNSAMPLE - 1) / CONE_DOWNSAMPLE;
 
-    // Uniform lokasyonlarını al
-    timeLocation = glGetUniformLocation(shaderProgram, "time");
-    resolutionLocation = glGetUniformLocation(shaderProgram, "resolution");
-    zoomLocation = glGetUniformLocation(shaderProgram, "zoom");
-    offsetLocation = glGetUniformLocation(shaderProgram, "offset");
-    juliaParamLocation = glGetUniformLocation(shaderProgram, "juliaParam");
-    modeLocation = glGetUniformLocation(shaderProgram, "mode");
-    complexityLocation = glGetUniformLocation(shaderProgram, "complexity");
+    parallelFor(blocksX * blocksY, [&](int block) {
+        int bx = (block % blocksX) * CONE_DOWNSAMPLE;
+        int by = (block / blocksX) * CONE_DOWNSAMPLE;
+        double tStart = coneStart(scene, bx + 0.5 * CONE_DOWNSAMPLE, by + 0.5 * CONE_DOWNSAMPLE, CONE_DOWNSAMPLE);
+        for (int y = by; y < std::min(by + CONE_DOWNSAMPLE, height); y++)
+        {
+            for (int x = bx; x < std::min(bx + CONE_DOWNSAMPLE, width); x++)
+            {
+                Vec3 color = shadeQuaternionPixel(scene, x + 0.5, y + 0.5, tStart);
+                uint8_t *out = &image[((size_t)(height - 1 - y) * width + x) * 3];
+                double channels[3] = {color.x, color.y, color.z};
+                for (int i = 0; i < 3; i++)
+                    out[i] = (uint8_t)(std::pow(std::max(0.0, std::min(1.0, channels[i])), 1.0 / 2.2) * 255.0 + 0.5);
+            }
+        }
+    });
+    return image;
 }
 
-// Quad mesh oluşturma
-void initQuad()
+bool writePPM(const std::string &path, int width, int height, const std::vector<uint8_t> &rgb)
 {
-    float quadVertices[] = {
-        // Pozisyonlar   // Texture koordinatları
-        -1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-        -1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
-        1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    file << "P6\n" << width << " " << height << "\n255\n";
+    file.write((const char *)rgb.data(), rgb.size());
+    return (bool)file;
+}
 
-        -1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-        1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-        1.0f, 1.0f, 0.0f, 1.0f, 1.0f};
+// Otomatik keşif
+//
+// Tile modunun distorsiyonsuz düzleminde, mevcut görünümden başlayarak
+// yüksek detaylı bölgeleri arar. Her seviyede EXPLORE_GRID x EXPLORE_GRID
+// aday bölge düşük çözünürlükte, double hassasiyetle ve paralel olarak
+// değerlendirilir; sınır yoğunluğu ile kaçış süresi entropisinin çarpımı en
+// yüksek olan aday seçilip bir sonraki seviyeye inilir. Sonuç, kamera betiği
+// olarak kullanılabilen bir zoom yoludur.
+const int EXPLORE_SAMPLES = 24;       // Aday başına örnek ızgarası kenarı
+const int EXPLORE_GRID = 8;           // Seviye başına aday ızgarası kenarı
+const double EXPLORE_ZOOM_STEP = 4.0; // Seviyeler arası büyütme
+const double EXPLORE_TARGET_SIZE = 1e-12;
+const int EXPLORE_HISTOGRAM_BINS = 32;
+const double MAX_DISPLAY_ZOOM = 1e5;  // Float shader hassasiyetinin sınırı
 
-    glGenVertexArrays(1, &quadVAO);
-    glGenBuffers(1, &quadVBO);
+struct ExploreStep
+{
+    double x, y; // Bölge merkezi
+    double size; // Bölgenin dikey kenarı (görünümde 3 / zoom)
+    double score;
+};
 
-    glBindVertexArray(quadVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+std::atomic<bool> explorerCancel{false};
+
+// Bölgeyi düşük çözünürlükte hesapla ve detay skorunu döndür
+double scoreRegion(double centerX, double centerY, double size, double cx, double cy, int maxIter)
+{
+    int iterations[EXPLORE_SAMPLES][EXPLORE_SAMPLES];
+    int histogram[EXPLORE_HISTOGRAM_BINS] = {};
+    double step = size / EXPLORE_SAMPLES;
+    double logMax = std::log((double)maxIter + 1.0);
+
+    for (int j = 0; j < EXPLORE_SAMPLES; j++)
+    {
+        for (int i = 0; i < EXPLORE_SAMPLES; i++)
+        {
+            double zx = centerX + (i + 0.5 - 0.5 * EXPLORE_SAMPLES) * step;
+            double zy = centerY + (j + 0.5 - 0.5 * EXPLORE_SAMPLES) * step;
+            int iter = 0;
+            for (; iter < maxIter; iter++)
+            {
+                double x2 = zx * zx, y2 = zy * zy;
+                if (x2 + y2 > 4.0)
+                    break;
+                zy = 2.0 * zx * zy + cy;
+                zx = x2 - y2 + cx;
+            }
+            iterations[j][i] = iter;
+            int bin = (int)(std::log(iter + 1.0) / logMax * (EXPLORE_HISTOGRAM_BINS - 1));
+            histogram[bin]++;
+        }
+    }
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void *)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void *)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    // Sınır yoğunluğu: iterasyon sayısı farklı olan komşu çiftlerin oranı
+    int edges = 0, boundary = 0;
+    for (int j = 0; j < EXPLORE_SAMPLES; j++)
+    {
+        for (int i = 0; i < EXPLORE_SAMPLES; i++)
+        {
+            if (i + 1 < EXPLORE_SAMPLES)
+            {
+                edges++;
+                boundary += iterations[j][i] != iterations[j][i + 1];
+            }
+            if (j + 1 < EXPLORE_SAMPLES)
+            {
+                edges++;
+                boundary += iterations[j][i] != iterations[j + 1][i];
+            }
+        }
+    }
+
+    // Kaçış süresi histogramının normalize Shannon entropisi
+    double entropy = 0.0;
+    const double total = EXPLORE_SAMPLES * EXPLORE_SAMPLES;
+    for (int count : histogram)
+    {
+        if (count == 0)
+            continue;
+        double probability = count / total;
+        entropy -= probability * std::log(probability);
+    }
+    entropy /= std::log((double)EXPLORE_HISTOGRAM_BINS);
+
+    return entropy * boundary / edges;
+}
+
+// Başlangıç bölgesinden hedef derinliğe açgözlü iniş. Aday sayısını
+// candidateCount'a yazar; tüm adaylar boşsa yol erken biter.
+std::vector<ExploreStep> explorePath(ExploreStep start, double cx, double cy, uint64_t &candidateCount)
+{
+    std::vector<ExploreStep> path;
+    path.push_back(start);
+    candidateCount = 0;
+
+    ExploreStep current = start;
+    const int candidates = EXPLORE_GRID * EXPLORE_GRID;
+    std::vector<ExploreStep> scored(candidates);
+    while (current.size > EXPLORE_TARGET_SIZE && !explorerCancel.load(std::memory_order_relaxed))
+    {
+        double childSize = current.size / EXPLORE_ZOOM_STEP;
+        // Derinleştikçe sınır detayı için daha fazla iterasyon gerekir
+        int maxIter = 200 + (int)(60.0 * std::log2(start.size / childSize));
+
+        parallelFor(candidates, [&](int index) {
+            // Aday merkezleri, alt bölgeler mevcut bölgenin içinde kalacak şekilde
+            double span = current.size - childSize;
+            double fx = ((index % EXPLORE_GRID) + 0.5) / EXPLORE_GRID - 0.5;
+            double fy = ((index / EXPLORE_GRID) + 0.5) / EXPLORE_GRID - 0.5;
+            ExploreStep &candidate = scored[index];
+            candidate.x = current.x + fx * span;
+            candidate.y = current.y + fy * span;
+            candidate.size = childSize;
+            candidate.score = scoreRegion(candidate.x, candidate.y, childSize, cx, cy, maxIter);
+        });
+        candidateCount += candidates;
+
+        auto best = std::max_element(scored.begin(), scored.end(),
+                                     [](const ExploreStep &a, const ExploreStep &b) { return a.score < b.score; });
+        if (best->score <= 0.0)
+            break;
+        current = *best;
+        path.push_back(current);
+    }
+    return path;
+}
+
+// Yolu kamera betiği olarak yaz: her satır "zoom offsetX offsetY"
+bool writeExplorePath(const std::string &filePath, const std::vector<ExploreStep> &path, double cx, double cy)
+{
+    FILE *file = fopen(filePath.c_str(), "w");
+    if (!file)
+        return false;
+    fprintf(file, "# julia c = %.9g %.9g\n# zoom offsetX offsetY score\n", cx, cy);
+    for (const ExploreStep &step : path)
+        fprintf(file, "%.17g %.17g %.17g %.6f\n", 3.0 / step.size, step.x, step.y, step.score);
+    fclose(file);
+    return true;
+}
+
+// Keşif arka planda çalışır, input thread'i yalnızca bitişi yoklar
+std::string explorePathFile = "explore_path.txt";
+std::thread explorerThread;
+std::atomic<bool> explorerRunning{false};
+std::atomic<bool> explorerDone{false};
+std::vector<ExploreStep> exploredPath; // explorerDone (release) ile yayınlanır
+
+// Kamera betiği oynatımı (input thread'i)
+std::vector<ExploreStep> playbackPath;
+double playbackPosition = -1.0; // Yol üzerindeki adım (kesirli); < 0 = kapalı
+const double PLAYBACK_STEPS_PER_SECOND = 0.75;
+
+void startAutoExplore()
+{
+    if (explorerRunning.load(std::memory_order_acquire))
+        return;
+    if (explorerThread.joinable())
+        explorerThread.join();
+
+    ExploreStep start = {offsetX, offsetY, 3.0 / zoom, 0.0};
+    double cx = juliaX, cy = juliaY;
+    explorerRunning.store(true, std::memory_order_release);
+    explorerThread = std::thread([start, cx, cy]() {
+        int64_t startNs = nowNs();
+        uint64_t candidates = 0;
+        std::vector<ExploreStep> path = explorePath(start, cx, cy, candidates);
+        double seconds = (nowNs() - startNs) / 1e9;
+        std::cout << "Auto-explore: " << path.size() - 1 << " levels, size " << path.back().size << ", "
+                  << candidates << " candidates in " << seconds << " s (" << candidates / seconds
+                  << " candidates/s)" << std::endl;
+        if (writeExplorePath(explorePathFile, path, cx, cy))
+            std::cout << "Zoom path saved to " << explorePathFile << std::endl;
+        exploredPath = std::move(path);
+        explorerDone.store(true, std::memory_order_release);
+        explorerRunning.store(false, std::memory_order_release);
+    });
+}
+
+void stopAutoExplore()
+{
+    explorerCancel.store(true, std::memory_order_relaxed);
+    if (explorerThread.joinable())
+        explorerThread.join();
+}
+
+// Keşif bittiyse oynatımı başlat, oynatım sürüyorsa kamerayı ilerlet
+void updatePlayback(float dt)
+{
+    if (explorerDone.exchange(false, std::memory_order_acquire))
+    {
+        playbackPath = std::move(exploredPath);
+        playbackPosition = 0.0;
+    }
+    if (playbackPosition < 0.0 || playbackPath.size() < 2)
+        return;
+
+    playbackPosition += dt * PLAYBACK_STEPS_PER_SECOND;
+    size_t index = (size_t)playbackPosition;
+    if (index + 1 >= playbackPath.size())
+    {
+        playbackPosition = -1.0;
+        return;
+    }
+    const ExploreStep &from = playbackPath[index];
+    const ExploreStep &to = playbackPath[index + 1];
+    double f = playbackPosition - index;
+
+    // Boyut logaritmik, merkez hedef ekranda sabit kalacak şekilde ilerler
+    double size = std::exp(std::log(from.size) + (std::log(to.size) - std::log(from.size)) * f);
+    double g = (from.size - size) / (from.size - to.size);
+    if (3.0 / size > MAX_DISPLAY_ZOOM)
+    {
+        std::cout << "Playback stopped at display precision limit (full path in " << explorePathFile << ")" << std::endl;
+        playbackPosition = -1.0;
+        return;
+    }
+    zoom = (float)(3.0 / size);
+    offsetX = (float)(from.x + (to.x - from.x) * g);
+    offsetY = (float)(from.y + (to.y - from.y) * g);
 }
 
 // Fare kontrolü için değişkenler
 int lastX = 0, lastY = 0;
 bool isDragging = false;
 
-void display()
+// Girdi olayını zaman damgasıyla işaretle. Render thread bir önceki grubu
+// çizime almadan gelen olaylar aynı gruba birleştirilir; grup alındıktan
+// sonra gelen olay o kareye yansımayacağı için yeni bir grup başlatır.
+void markInput()
 {
-    glClear(GL_COLOR_BUFFER_BIT);
+    if (pendingInputNs != 0 && consumedInputNs.load(std::memory_order_acquire) >= pendingInputNs)
+        pendingInputNs = 0;
+    if (pendingInputNs == 0)
+        pendingInputNs = nowNs();
+}
+
+// Input thread'indeki parametrelerin anlık kopyası
+FrameParams currentParams()
+{
+    FrameParams p;
+    p.zoom = zoom;
+    p.offsetX = offsetX;
+    p.offsetY = offsetY;
+    p.juliaX = juliaX;
+    p.juliaY = juliaY;
+    p.time = time_value;
+    p.colorMode = colorMode;
+    p.complexity = complexity;
+    p.viewMode = viewMode;
+    p.videoAmount = (videoInput.isOpen() && videoEffect) ? 1.0f : 0.0f;
+    p.viewportWidth = viewportWidth;
+    p.viewportHeight = viewportHeight;
+    p.inputTimeNs = pendingInputNs;
+    return p;
+}
+
+// Mevcut parametrelerin değişmez kopyasını render thread'ine yayınla
+void publishParams()
+{
+    frameParams.writeBuffer() = currentParams();
+    frameParams.publish();
+}
 
-    glUseProgram(shaderProgram);
+// Kareyi çiz; eksik kalan iş varsa (ör. üretilmemiş tile) true döner
+bool drawFrame(const FrameParams &p)
+{
+    if (p.viewMode == VIEW_TILES)
+        return drawTileView(p);
 
-    // Uniform değişkenleri güncelle
-    glUniform1f(timeLocation, time_value);
-    glUniform2f(resolutionLocation, WIDTH, HEIGHT);
-    glUniform1f(zoomLocation, zoom);
-    glUniform2f(offsetLocation, offsetX, offsetY);
-    glUniform2f(juliaParamLocation, juliaX, juliaY);
-    glUniform1i(modeLocation, colorMode);
-    glUniform1f(complexityLocation, complexity);
+    FractalParams fractal;
+    fractal.zoom = p.zoom;
+    fractal.offsetX = p.offsetX;
+    fractal.offsetY = p.offsetY;
+    fractal.juliaX = p.juliaX;
+    fractal.juliaY = p.juliaY;
+    fractal.time = p.time;
+    fractal.colorMode = p.colorMode;
+    fractal.complexity = p.complexity;
+    fractal.viewMode = p.viewMode == VIEW_QUATERNION ? FRACTAL_VIEW_QUATERNION : FRACTAL_VIEW_CLASSIC;
+    fractal.videoAmount = p.videoAmount;
+    mainRenderer.setParams(fractal);
+    mainRenderer.renderTo(0, p.viewportWidth, p.viewportHeight);
+    return false;
+}
 
-    // Quad'ı çiz
-    glBindVertexArray(quadVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+void recordLatency(int64_t inputNs)
+{
+    uint64_t latency = (uint64_t)(nowNs() - inputNs);
+    latencySamples.fetch_add(1, std::memory_order_relaxed);
+    latencyTotalNs.fetch_add(latency, std::memory_order_relaxed);
+    latencyLastNs.store(latency, std::memory_order_relaxed);
+    uint64_t prevMax = latencyMaxNs.load(std::memory_order_relaxed);
+    while (latency > prevMax && !latencyMaxNs.compare_exchange_weak(prevMax, latency, std::memory_order_relaxed))
+    {
+    }
+}
+
+// Render thread: GL context'in tek sahibi. Yalnızca yayınlanan parametre
+// kopyalarını okur, input thread'ini hiçbir zaman bekletmez.
+void renderLoop()
+{
+    if (!makeContextCurrent(glContext))
+    {
+        std::cerr << "Render context could not be made current" << std::endl;
+        return;
+    }
+
+    // Shader ve quad başlatma
+    initTelemetry();
+    if (!mainRenderer.init())
+        std::cerr << "Fractal renderer initialization failed" << std::endl;
+    createFractalQuad(quadVAO, quadVBO);
+    initTiles();
+    gpuTelemetry.init();
+    videoInput.initGL();
+    mainRenderer.setVideoTextures(videoInput.planeTexture(0), videoInput.planeTexture(1), videoInput.planeTexture(2));
 
-    glutSwapBuffers();
+    int64_t lastPresentedInput = 0;
+    int64_t lastSwapNs = 0;
+    bool haveFrame = false;
+    bool pendingWork = false;
+    while (!renderStop.load(std::memory_order_acquire))
+    {
+        // Parametreleri çizimden hemen önce oku ki en taze girdi kullanılsın
+        bool updated = frameParams.update();
+        if (!updated && haveFrame && !pendingWork)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(250));
+            continue;
+        }
+        haveFrame = true;
+        const FrameParams &p = frameParams.readBuffer();
+        // Bundan sonra gelen girdiler bu kareye yansımaz
+        if (updated && p.inputTimeNs != 0)
+            consumedInputNs.store(p.inputTimeNs, std::memory_order_release);
+
+        FrameSample sample = {};
+        sample.gpuTimeNs = -1;
+        gpuTelemetry.collect(sample);
+        int64_t frameStartNs = nowNs();
+
+        gpuTelemetry.beginFrame();
+        videoInput.update();
+        pendingWork = drawFrame(p);
+        gpuTelemetry.endFrame();
+        swapContextBuffers(glContext);
+        // GPU kuyruğunu bir karede tut: sürücünün kareleri biriktirmesi gecikmeyi artırır
+        glFinish();
+
+        int64_t swapNs = nowNs();
+        sample.cpuFrameNs = swapNs - frameStartNs;
+        sample.intervalNs = lastSwapNs ? swapNs - lastSwapNs : 0;
+        lastSwapNs = swapNs;
+        if (!telemetryRing.push(sample))
+            telemetryDropped.fetch_add(1, std::memory_order_relaxed);
+
+        if (p.inputTimeNs != 0 && p.inputTimeNs != lastPresentedInput)
+        {
+            recordLatency(p.inputTimeNs);
+            lastPresentedInput = p.inputTimeNs;
+        }
+    }
+
+    // Temizlik
+    videoInput.shutdown();
+    gpuTelemetry.destroy();
+    destroyTiles();
+    glDeleteVertexArrays(1, &quadVAO);
+    glDeleteBuffers(1, &quadVBO);
+    mainRenderer.destroy();
+
+    releaseCurrentContext(glContext);
+}
+
+void startRenderThread()
+{
+    // GLUT'un context'i bu thread'de aktif kalır; render thread'i paylaşımlı
+    // kendi context'ini kullanır
+    glContext = createSharedContext();
+    publishParams();
+    renderThread = std::thread(renderLoop);
+}
+
+void stopRenderThread()
+{
+    renderStop.store(true, std::memory_order_release);
+    if (!renderThread.joinable())
+        return;
+    renderThread.join();
+    destroyContext(glContext);
+}
+
+// GLUT çizim callback'i artık yalnızca yeni bir kare ister; çizim render thread'inde
+void display()
+{
+    publishParams();
 }
 
 void reshape(int w, int h)
 {
-    glViewport(0, 0, w, h);
+    viewportWidth = w;
+    viewportHeight = h;
+    publishParams();
+}
+
+void printLatency()
+{
+    uint64_t samples = latencySamples.load(std::memory_order_relaxed);
+    if (samples == 0)
+    {
+        std::cout << "Input latency: no samples yet" << std::endl;
+        return;
+    }
+    std::cout << "Input latency: last " << latencyLastNs.load(std::memory_order_relaxed) / 1e6
+              << " ms, avg " << latencyTotalNs.load(std::memory_order_relaxed) / 1e6 / samples
+              << " ms, max " << latencyMaxNs.load(std::memory_order_relaxed) / 1e6
+              << " ms (" << samples << " frames)" << std::endl;
+}
+
+void onClose()
+{
+    stopRenderThread();
 }
 
 void motion(int x, int y)
 {
     if (isDragging)
     {
-        float dx = (x - lastX) * 2.0f / WIDTH / zoom;
-        float dy = (y - lastY) * 2.0f / HEIGHT / zoom;
+        markInput();
+        float dx, dy;
+        if (viewMode == VIEW_TILES)
+        {
+            // Tile görünümünün piksel <-> düzlem eşlemesi: sürüklenen nokta imlecin altında kalır
+            float worldPerPixel = 3.0f / (zoom * std::min(viewportWidth, viewportHeight));
+            dx = (x - lastX) * worldPerPixel;
+            dy = (y - lastY) * worldPerPixel;
+        }
+        else
+        {
+            dx = (x - lastX) * 2.0f / WIDTH / zoom;
+            dy = (y - lastY) * 2.0f / HEIGHT / zoom;
+        }
         offsetX -= dx;
         offsetY += dy;
         lastX = x;
         lastY = y;
-        glutPostRedisplay();
+        publishParams();
     }
 }
 
 void mouse(int button, int state, int x, int y)
 {
+    // Elle kontrol kamera betiği oynatımını durdurur
+    if (state == GLUT_DOWN)
+        playbackPosition = -1.0;
+
     if (button == GLUT_LEFT_BUTTON)
     {
         if (state == GLUT_DOWN)
@@ -361,23 +2561,29 @@ void mouse(int button, int state, int x, int y)
     }
     else if (button == 3)
     { // Fare tekerleği yukarı
+        markInput();
         zoom *= 1.1f;
-        glutPostRedisplay();
+        publishParams();
     }
     else if (button == 4)
     { // Fare tekerleği aşağı
+        markInput();
         zoom /= 1.1f;
-        glutPostRedisplay();
+        publishParams();
     }
 }
 
 void keyboard(unsigned char key, int x, int y)
 {
+    // Yalnızca konsola yazan tuşlar ekranda bir şey değiştirmez
+    if (key != 'h' && key != 'l')
+        markInput();
     switch (key)
     {
     case 27: // ESC
+        stopRenderThread();
         glutLeaveMainLoop();
-        break;
+        return;
     case 'r':
         autoRotate = !autoRotate;
         std::cout << "Auto rotation: " << (autoRotate ? "ON" : "OFF") << std::endl;
@@ -418,6 +2624,29 @@ void keyboard(unsigned char key, int x, int y)
             complexity = 0.0f;
         std::cout << "Complexity: " << complexity << std::endl;
         break;
+    case 'l':
+        printLatency();
+        break;
+    case 'v':
+        videoEffect = !videoEffect;
+        std::cout << "Video effect: " << (videoEffect && videoInput.isOpen() ? "ON" : "OFF") << std::endl;
+        break;
+    case 't':
+        viewMode = viewMode == VIEW_TILES ? VIEW_CLASSIC : VIEW_TILES;
+        std::cout << "Tile explorer mode: " << (viewMode == VIEW_TILES ? "ON" : "OFF") << std::endl;
+        break;
+    case 'a':
+        if (explorerRunning.load(std::memory_order_acquire))
+            break;
+        // Aday skorları distorsiyonsuz düzlemde hesaplanır; aynı düzlemi göster
+        viewMode = VIEW_TILES;
+        std::cout << "Auto-explore started" << std::endl;
+        startAutoExplore();
+        break;
+    case '3':
+        viewMode = viewMode == VIEW_QUATERNION ? VIEW_CLASSIC : VIEW_QUATERNION;
+        std::cout << "3D quaternion mode: " << (viewMode == VIEW_QUATERNION ? "ON" : "OFF") << std::endl;
+        break;
     case 'h':
         std::cout << "\n=== PSYCHEDELIC JULIA FRACTAL EXPLORER CONTROLS ===" << std::endl;
         std::cout << "ESC       - Exit" << std::endl;
@@ -427,19 +2656,25 @@ void keyboard(unsigned char key, int x, int y)
         std::cout << "C/Shift+C - Change color palette" << std::endl;
         std::cout << "X/Shift+X - Adjust complexity of distortions and animations" << std::endl;
         std::cout << "Mouse     - Pan (drag) and Zoom (wheel)" << std::endl;
+        std::cout << "T         - Toggle cached tile explorer (static plane, fast panning)" << std::endl;
+        std::cout << "A         - Auto-explore: find a deep high-detail zoom path and fly it" << std::endl;
+        std::cout << "3         - Toggle 3D quaternion julia (drag orbits the camera)" << std::endl;
+        std::cout << "V         - Toggle video displacement (--video=FILE)" << std::endl;
+        std::cout << "L         - Show input-to-photon latency" << std::endl;
         std::cout << "H         - Show this help" << std::endl;
         std::cout << "=====================================================\n"
                   << std::endl;
         break;
     }
-    glutPostRedisplay();
+    publishParams();
 }
 
 void update(int value)
 {
     time_value += 0.016f; // Yaklaşık 60 FPS
 
-    if (autoRotate)
+    // Keşif modunda julia parametresi sabit kalır ki tile'lar yeniden kullanılabilsin
+    if (autoRotate && viewMode != VIEW_TILES)
     {
         // Dinamik dönüş hızı, zamanla değişen psychedelic bir etki için
         float currentRotationSpeed = rotationSpeed * (1.0 + sin(time_value * 0.5) * 0.5);
@@ -450,19 +2685,88 @@ void update(int value)
         juliaY = tempY;
     }
 
+    updatePlayback(0.016f);
+
     // Ek dinamik efektler (opsiyonel, denenebilir)
     // zoom = 2.5f + sin(time_value * 0.1) * 1.5f; // Zoomda dalgalanma
     // offsetX = sin(time_value * 0.08) * 0.5f; // Offset'te yatay hareket
     // offsetY = cos(time_value * 0.12) * 0.5f; // Offset'te dikey hareket
     // complexity = 0.5f + sin(time_value * 0.2) * 0.5f; // Karmaşıklıkta dalgalanma
 
-    glutPostRedisplay();
+    publishParams();
     glutTimerFunc(16, update, 0); // 16 ms sonra tekrar çağır (yaklaşık 60 FPS)
 }
 
 int main(int argc, char **argv)
 {
+    // Uygulama argümanları (GLUT tanımadıklarını yok sayar)
+    std::string headlessPath;
+    std::string videoPath;
+    int headlessWidth = WIDTH, headlessHeight = HEIGHT;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        // Başlangıç parametreleri (başsız çizim de bunları kullanır)
+        bool valid = true;
+        if (arg.rfind("--julia=", 0) == 0)
+            valid = sscanf(arg.c_str() + 8, "%f,%f", &juliaX, &juliaY) == 2;
+        else if (arg.rfind("--time=", 0) == 0)
+            valid = sscanf(arg.c_str() + 7, "%f", &time_value) == 1;
+        else if (arg.rfind("--zoom=", 0) == 0)
+            valid = sscanf(arg.c_str() + 7, "%f", &zoom) == 1 && zoom > 0.0f;
+        else if (arg.rfind("--offset=", 0) == 0)
+            valid = sscanf(arg.c_str() + 9, "%f,%f", &offsetX, &offsetY) == 2;
+        else if (arg.rfind("--complexity=", 0) == 0)
+            valid = sscanf(arg.c_str() + 13, "%f", &complexity) == 1;
+        else if (arg.rfind("--palette=", 0) == 0)
+            valid = sscanf(arg.c_str() + 10, "%d", &colorMode) == 1 && colorMode >= 0 && colorMode < 4;
+        else if (arg.rfind("--size=", 0) == 0)
+            valid = sscanf(arg.c_str() + 7, "%dx%d", &headlessWidth, &headlessHeight) == 2 &&
+                    headlessWidth > 0 && headlessHeight > 0;
+        if (!valid)
+        {
+            std::cerr << "Invalid argument: " << arg << std::endl;
+            return 1;
+        }
+
+        if (arg.rfind("--tile-cache=", 0) == 0)
+            tileCacheDir = arg.substr(13);
+        else if (arg.rfind("--metrics-socket=", 0) == 0)
+            metricsSocketPath = arg.substr(17);
+        else if (arg.rfind("--video=", 0) == 0)
+            videoPath = arg.substr(8);
+        else if (arg.rfind("--headless-3d=", 0) == 0)
+            headlessPath = arg.substr(14);
+        else if (arg.rfind("--explore-path=", 0) == 0)
+            explorePathFile = arg.substr(15);
+    }
+
+    // Başsız düğüm: pencere açmadan 3D kareyi CPU'da çiz ve çık. Sahne
+    // --julia, --time, --zoom, --offset (kamera), --complexity, --palette ve
+    // --size ile seçilir.
+    if (!headlessPath.empty())
+    {
+        int64_t startNs = nowNs();
+        std::vector<uint8_t> image = renderQuaternionCPU(currentParams(), headlessWidth, headlessHeight);
+        if (!writePPM(headlessPath, headlessWidth, headlessHeight, image))
+        {
+            std::cerr << "Cannot write " << headlessPath << std::endl;
+            return 1;
+        }
+        std::cout << "Rendered " << headlessPath << " in " << (nowNs() - startNs) / 1e6 << " ms" << std::endl;
+        return 0;
+    }
+
+    // Video yalnızca pencereli çalıştırmada kullanılır
+    if (!videoPath.empty())
+        videoInput.open(videoPath);
+
+#ifndef _WIN32
+    // Render thread da aynı X bağlantısı üzerinden buffer takası yapıyor
+    XInitThreads();
+#endif
     glutInit(&argc, argv);
+    glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_GLUTMAINLOOP_RETURNS);
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA);
     glutInitWindowSize(WIDTH, HEIGHT);
     glutCreateWindow("🌈 Psychedelic Julia Fractal Explorer 🌌");
@@ -478,10 +2782,6 @@ int main(int argc, char **argv)
     // OpenGL ayarları
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
-    // Shader ve quad başlatma
-    initShaders();
-    initQuad();
-
     // Başlangıç mesajı
     std::cout << "\n🌈 PSYCHEDELIC JULIA FRACTAL EXPLORER 🌌" << std::endl;
     std::cout << "Press 'H' for help and controls" << std::endl;
@@ -494,14 +2794,18 @@ int main(int argc, char **argv)
     glutMotionFunc(motion);
     glutMouseFunc(mouse);
     glutKeyboardFunc(keyboard);
+    glutCloseFunc(onClose);
     glutTimerFunc(0, update, 0);
 
+    // Çizim render thread'inde; bu thread yalnızca girdi işler
+    startTelemetry();
+    startRenderThread();
+
     glutMainLoop();
 
-    // Temizlik
-    glDeleteVertexArrays(1, &quadVAO);
-    glDeleteBuffers(1, &quadVBO);
-    glDeleteProgram(shaderProgram);
+    stopRenderThread();
+    stopTelemetry();
+    stopAutoExplore();
 
     return 0;
 }
\ No newline at end of file